@@ -63,6 +63,10 @@ function osdmodulesbuild()
 		MAME_DIR .. "src/osd/modules/monitor/monitor_module.h",
 		MAME_DIR .. "src/osd/modules/lib/osdobj_common.cpp",
 		MAME_DIR .. "src/osd/modules/lib/osdobj_common.h",
+		MAME_DIR .. "src/osd/modules/lib/audiocapture.cpp",
+		MAME_DIR .. "src/osd/modules/lib/audiocapture.h",
+		MAME_DIR .. "src/osd/modules/lib/audioring.cpp",
+		MAME_DIR .. "src/osd/modules/lib/audioring.h",
 		MAME_DIR .. "src/osd/modules/diagnostics/none.cpp",
 		MAME_DIR .. "src/osd/modules/diagnostics/diagnostics_win32.cpp",
 		MAME_DIR .. "src/osd/modules/debugger/none.cpp",
@@ -121,6 +125,7 @@ function osdmodulesbuild()
 	}
 	includedirs {
 		ext_includedir("asio"),
+		ext_includedir("flac"),
 	}
 
 	if _OPTIONS["targetos"]=="windows" or _OPTIONS["targetos"]=="winui" then
@@ -132,6 +132,30 @@ static constexpr u8 line_315_5377[8] = { 26, 26, 27, 28 /* not verified */, 24,
 #define DRAW_TIME_SMS         63      /* 26 + 2 + 14 + 8 + 13 */
 
 
+/* Mode 4 patterns are four bitplanes, MSB leftmost. Each plane byte is
+   spread into the low bit of eight nibbles (leftmost pixel in the lowest
+   nibble), so a row decodes to its eight 4-bit pens with four lookups. */
+struct mode4_plane_table
+{
+	constexpr mode4_plane_table() : spread()
+	{
+		for (int data = 0; data < 0x100; data++)
+			for (int pixel_x = 0; pixel_x < 8; pixel_x++)
+				spread[data] |= u32((data >> (7 - pixel_x)) & 1) << (pixel_x << 2);
+	}
+
+	u32 spread[0x100];
+};
+
+static constexpr mode4_plane_table mode4_planes;
+
+static inline u32 mode4_row_pens(u8 bit_plane_0, u8 bit_plane_1, u8 bit_plane_2, u8 bit_plane_3)
+{
+	return mode4_planes.spread[bit_plane_0] | (mode4_planes.spread[bit_plane_1] << 1) |
+			(mode4_planes.spread[bit_plane_2] << 2) | (mode4_planes.spread[bit_plane_3] << 3);
+}
+
+
 DEFINE_DEVICE_TYPE(SEGA315_5124, sega315_5124_device, "sega315_5124", "Sega 315-5124 SMS1 VDP")
 DEFINE_DEVICE_TYPE(SEGA315_5246, sega315_5246_device, "sega315_5246", "Sega 315-5246 SMS2 VDP")
 DEFINE_DEVICE_TYPE(SEGA315_5377, sega315_5377_device, "sega315_5377", "Sega 315-5377 Gamegear VDP")
@@ -1130,20 +1154,15 @@ void sega315_5124_device::draw_scanline_mode4(int *line_buffer, int *priority_se
 		if (tile_column == 0 && fine_x_scroll > 0)
 			draw_leftmost_pixels_mode4(line_buffer, priority_selected, fine_x_scroll, palette_selected, tile_line);
 
+		const u32 pens = mode4_row_pens(bit_plane_0, bit_plane_1, bit_plane_2, bit_plane_3);
+		const u8 palette_bits = palette_selected ? 0x10 : 0x00;
+		const int column_x = fine_x_scroll + (tile_column << 3);
+
 		for (int pixel_x = 0; pixel_x < 8; pixel_x++)
 		{
-			const u8 pen_bit_0 = BIT(bit_plane_0, 7 - pixel_x);
-			const u8 pen_bit_1 = BIT(bit_plane_1, 7 - pixel_x);
-			const u8 pen_bit_2 = BIT(bit_plane_2, 7 - pixel_x);
-			const u8 pen_bit_3 = BIT(bit_plane_3, 7 - pixel_x);
-
-			u8 pen_selected = (pen_bit_3 << 3 | pen_bit_2 << 2 | pen_bit_1 << 1 | pen_bit_0);
-			if (palette_selected)
-				pen_selected |= 0x10;
+			const u8 pen_selected = ((pens >> (pixel_x << 2)) & 0x0f) | palette_bits;
 
-			int pixel_plot_x = !horiz_selected ? pixel_x : (7 - pixel_x);
-
-			pixel_plot_x = fine_x_scroll + (tile_column << 3) + pixel_plot_x;
+			const int pixel_plot_x = column_x + (!horiz_selected ? pixel_x : (7 - pixel_x));
 			if (pixel_plot_x < 256)
 			{
 				line_buffer[pixel_plot_x] = m_current_palette[pen_selected];
@@ -1439,14 +1458,12 @@ void sega315_5124_device::draw_sprites_mode4(int *line_buffer, int *priority_sel
 		const u8 bit_plane_1 = space().read_byte((sprite_tile_selected << 5) + sprite_pattern_line + 0x01);
 		const u8 bit_plane_2 = space().read_byte((sprite_tile_selected << 5) + sprite_pattern_line + 0x02);
 		const u8 bit_plane_3 = space().read_byte((sprite_tile_selected << 5) + sprite_pattern_line + 0x03);
+		const u32 pens = mode4_row_pens(bit_plane_0, bit_plane_1, bit_plane_2, bit_plane_3);
 
-		for (int pixel_x = 0; pixel_x < 8; pixel_x++)
+		// a fully transparent row draws nothing and can't collide
+		for (int pixel_x = 0; pens && pixel_x < 8; pixel_x++)
 		{
-			const u8 pen_bit_0 = BIT(bit_plane_0, 7 - pixel_x);
-			const u8 pen_bit_1 = BIT(bit_plane_1, 7 - pixel_x);
-			const u8 pen_bit_2 = BIT(bit_plane_2, 7 - pixel_x);
-			const u8 pen_bit_3 = BIT(bit_plane_3, 7 - pixel_x);
-			const u8 pen_selected = (pen_bit_3 << 3 | pen_bit_2 << 2 | pen_bit_1 << 1 | pen_bit_0) | 0x10;
+			const u8 pen_selected = ((pens >> (pixel_x << 2)) & 0x0f) | 0x10;
 
 			if (pen_selected == 0x10) // Transparent palette so skip draw
 				continue;
@@ -1798,25 +1815,27 @@ void sega315_5124_device::blit_scanline(int *line_buffer, int *priority_selected
 {
 	u32 *const p_bitmap = &m_tmpbitmap.pix(pixel_plot_y + line, pixel_offset_x);
 	u8  *const p_y1 = &m_y1_bitmap.pix(pixel_plot_y + line, pixel_offset_x);
+	const pen_t *const pens = m_palette_lut->pens();
 	int x = 0;
 
 	if (m_vdp_mode == 4 && BIT(m_reg[0x00], 5))
 	{
 		/* Fill column 0 with overscan color from m_reg[0x07] */
+		const pen_t backdrop = pens[m_current_palette[BACKDROP_COLOR]];
+		const u8 backdrop_y1 = (m_reg[0x07] & 0x0f) ? 1 : 0;
 		do
 		{
-			p_bitmap[x] = m_palette_lut->pen(m_current_palette[BACKDROP_COLOR]);
-			p_y1[x] = (m_reg[0x07] & 0x0f) ? 1 : 0;
+			p_bitmap[x] = backdrop;
+			p_y1[x] = backdrop_y1;
 		}
 		while(++x < 8);
 	}
 
-	do
-	{
-		p_bitmap[x] = m_palette_lut->pen(line_buffer[x]);
-		p_y1[x] = (priority_selected[x] & 0x0f) ? 1 : 0;
-	}
-	while(++x < 256);
+	// kept as two plain loops so the compiler can vectorise the second
+	for (int i = x; i < 256; i++)
+		p_bitmap[i] = pens[line_buffer[i]];
+	for (int i = x; i < 256; i++)
+		p_y1[i] = (priority_selected[i] & 0x0f) != 0;
 }
 
 
@@ -61,6 +61,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_COMMENT_DIRECTORY,                          "config/comments",  OPTION_STRING,     "directory to save debugger comments" },
 	{ OPTION_VIDEO_DIRECTORY,                          	 "support/video",  	 OPTION_STRING,     "directory to save/load video files" },
 	{ OPTION_SHARE_DIRECTORY,                            "config/share",     OPTION_STRING,     "directory to share with emulated machines" },
+	{ OPTION_CRYPTCACHE_DIRECTORY,                       "",                 OPTION_STRING,     "directory to cache decrypted program ROMs in (empty to disable)" },
 
 	// state/playback options
 	{ nullptr,                                           nullptr,     OPTION_HEADER,     "CORE STATE/PLAYBACK OPTIONS" },
@@ -80,6 +81,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SNAPSIZE,                                   "auto",      OPTION_STRING,     "specify snapshot/movie resolution (<width>x<height>) or 'auto' to use minimal size " },
 	{ OPTION_SNAPVIEW,                                   "auto",      OPTION_STRING,     "snapshot/movie view - 'auto' for default, or 'native' for per-screen pixel-aspect views" },
 	{ OPTION_SNAPBILINEAR,                               "1",         OPTION_BOOLEAN,    "specify if the snapshot/movie should have bilinear filtering applied" },
+	{ OPTION_SNAPSEQUENCE,                               "0",         OPTION_INTEGER,    "save a PNG snapshot of every Nth frame as a numbered sequence (0 = off)" },
 	{ OPTION_STATENAME,                                  "%g",        OPTION_STRING,     "override of the default state subfolder naming; %g == gamename" },
 	{ OPTION_BURNIN,                                     "0",         OPTION_BOOLEAN,    "create burn-in snapshots for each screen" },
 
@@ -185,6 +187,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_UPDATEINPAUSE,                              "0",         OPTION_BOOLEAN,    "keep calling video updates while in pause" },
 	{ OPTION_DEBUGSCRIPT,                                nullptr,     OPTION_STRING,     "script for debugger" },
 	{ OPTION_DEBUGLOG,                                   "0",         OPTION_BOOLEAN,    "write debug console output to debug.log" },
+	{ OPTION_PERFTRACE,                                  nullptr,     OPTION_STRING,     "write timing of core emulation stages to the given file as Chrome trace JSON" },
 
 	// comm options
 	{ nullptr,                                           nullptr,     OPTION_HEADER,     "CORE COMM OPTIONS" },
@@ -193,6 +196,9 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_COMM_REMOTE_HOST,                           "127.0.0.1", OPTION_STRING,     "remote address to connect to" },
 	{ OPTION_COMM_REMOTE_PORT,                           "15112",     OPTION_STRING,     "remote port to connect to" },
 	{ OPTION_COMM_FRAME_SYNC,                            "0",         OPTION_BOOLEAN,    "sync frames" },
+	{ OPTION_COMM_ROLLBACK,                              "0",         OPTION_BOOLEAN,    "use rollback netplay for player inputs instead of lockstep link play" },
+	{ OPTION_COMM_ROLLBACK_FRAMES "(1-30)",              "8",         OPTION_INTEGER,    "maximum number of frames to run ahead of the remote player" },
+	{ OPTION_COMM_PLAYER "(1-2)",                        "1",         OPTION_INTEGER,    "local player number for rollback netplay" },
 
 	// misc options
 	{ nullptr,                                           nullptr,     OPTION_HEADER,     "CORE MISC OPTIONS" },
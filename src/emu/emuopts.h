@@ -49,6 +49,7 @@
 #define OPTION_COMMENT_DIRECTORY    "comment_directory"
 #define OPTION_VIDEO_DIRECTORY      "video_directory"
 #define OPTION_SHARE_DIRECTORY      "share_directory"
+#define OPTION_CRYPTCACHE_DIRECTORY "cryptcache_directory"
 
 // core state/playback options
 #define OPTION_STATE                "state"
@@ -66,6 +67,7 @@
 #define OPTION_SNAPSIZE             "snapsize"
 #define OPTION_SNAPVIEW             "snapview"
 #define OPTION_SNAPBILINEAR         "snapbilinear"
+#define OPTION_SNAPSEQUENCE         "snapsequence"
 #define OPTION_STATENAME            "statename"
 #define OPTION_BURNIN               "burnin"
 
@@ -161,6 +163,7 @@
 #define OPTION_UPDATEINPAUSE        "update_in_pause"
 #define OPTION_DEBUGSCRIPT          "debugscript"
 #define OPTION_DEBUGLOG             "debuglog"
+#define OPTION_PERFTRACE            "perftrace"
 
 // core misc options
 #define OPTION_DRC                  "drc"
@@ -181,6 +184,9 @@
 #define OPTION_COMM_REMOTE_HOST     "comm_remotehost"
 #define OPTION_COMM_REMOTE_PORT     "comm_remoteport"
 #define OPTION_COMM_FRAME_SYNC      "comm_framesync"
+#define OPTION_COMM_ROLLBACK        "comm_rollback"
+#define OPTION_COMM_ROLLBACK_FRAMES "comm_rollback_frames"
+#define OPTION_COMM_PLAYER          "comm_player"
 
 #define OPTION_CONFIRM_QUIT         "confirm_quit"
 #define OPTION_UI_MOUSE             "ui_mouse"
@@ -337,6 +343,7 @@ public:
 	const char *comment_directory() const { return value(OPTION_COMMENT_DIRECTORY); }
 	const char *video_directory() const { return value(OPTION_VIDEO_DIRECTORY); }
 	const char *share_directory() const { return value(OPTION_SHARE_DIRECTORY); }
+	const char *cryptcache_directory() const { return value(OPTION_CRYPTCACHE_DIRECTORY); }
 
 	// core state/playback options
 	const char *state() const { return value(OPTION_STATE); }
@@ -354,6 +361,7 @@ public:
 	const char *snap_size() const { return value(OPTION_SNAPSIZE); }
 	const char *snap_view() const { return value(OPTION_SNAPVIEW); }
 	bool snap_bilinear() const { return bool_value(OPTION_SNAPBILINEAR); }
+	int snap_sequence() const { return int_value(OPTION_SNAPSEQUENCE); }
 	const char *state_name() const { return value(OPTION_STATENAME); }
 	bool burnin() const { return bool_value(OPTION_BURNIN); }
 
@@ -447,6 +455,7 @@ public:
 	const char *debug_script() const { return value(OPTION_DEBUGSCRIPT); }
 	bool update_in_pause() const { return bool_value(OPTION_UPDATEINPAUSE); }
 	bool debuglog() const { return bool_value(OPTION_DEBUGLOG); }
+	const char *perftrace() const { return value(OPTION_PERFTRACE); }
 
 	// core misc options
 	bool drc() const { return bool_value(OPTION_DRC); }
@@ -467,6 +476,9 @@ public:
 	const char *comm_remotehost() const { return value(OPTION_COMM_REMOTE_HOST); }
 	const char *comm_remoteport() const { return value(OPTION_COMM_REMOTE_PORT); }
 	bool comm_framesync() const { return bool_value(OPTION_COMM_FRAME_SYNC); }
+	bool comm_rollback() const { return bool_value(OPTION_COMM_ROLLBACK); }
+	int comm_rollback_frames() const { return int_value(OPTION_COMM_ROLLBACK_FRAMES); }
+	int comm_player() const { return int_value(OPTION_COMM_PLAYER); }
 
 
 	bool confirm_quit() const { return bool_value(OPTION_CONFIRM_QUIT); }
@@ -95,16 +95,20 @@
 #include "config.h"
 #include "xmlfile.h"
 #include "profiler.h"
+#include "perftrace.h"
 #include "ui/uimain.h"
 #include "inputdev.h"
 #include "natkeyboard.h"
 
 #include "corestr.h"
+#include "hashing.h"
 #include "osdepend.h"
 #include "unicode.h"
 
+#include <algorithm>
 #include <cctype>
 #include <ctime>
+#include <map>
 
 
 namespace {
@@ -1768,6 +1772,640 @@ ioport_port_live::ioport_port_live(ioport_port &port)
 
 
 
+//**************************************************************************
+//  ROLLBACK NETPLAY
+//**************************************************************************
+
+/*
+    Rollback netplay lets two linked instances run at full speed without
+    waiting for each other every frame. Each frame the local player's
+    digital inputs are collected from the ioport fields into one bitfield
+    per port and sent to the peer. If the peer's input for a frame hasn't
+    arrived yet, it is predicted by repeating the last input received.
+    Analog inputs aren't exchanged, so systems that use them are refused.
+
+    A memory save state is taken at the start of every frame. When a remote
+    input arrives that differs from the prediction, the machine is restored
+    to the start of the mispredicted frame and the intervening frames are
+    replayed with video and sound suppressed until it catches up again.
+    The per-frame hook runs from the VBLANK timer in the middle of a
+    timeslice, so it only decides what to save or restore; the machine
+    calls handle_netplay() between timeslices, next to its own deferred
+    save and load handling, to actually do it.
+    Every NETPLAY_CHECK_INTERVAL frames both sides exchange a checksum of a
+    confirmed state so that a desync is reported instead of going unnoticed.
+
+    The link reuses the comm_localhost/comm_localport and
+    comm_remotehost/comm_remoteport sockets of lockstep link play.
+*/
+
+namespace {
+
+// packet types
+enum : u32
+{
+	NETPLAY_HELLO = 1,                          // frame = sender's player, arg = port layout checksum
+	NETPLAY_INPUT,                              // frame = frame number, followed by per-port input
+	NETPLAY_CHECK                               // frame = frame number, arg = state checksum
+};
+
+constexpr u32 NETPLAY_HEADER_SIZE = 12;         // type, frame and argument
+constexpr u32 NETPLAY_CHECK_INTERVAL = 60;      // frames between state checksum exchanges
+constexpr int NETPLAY_CONNECT_TIMEOUT = 60;     // seconds to wait for the peer to appear
+constexpr int NETPLAY_STALL_TIMEOUT = 10;       // seconds to wait for the peer to catch up
+
+inline u32 netplay_get(const u8 *src)
+{
+	return src[0] | (src[1] << 8) | (src[2] << 16) | (u32(src[3]) << 24);
+}
+
+inline void netplay_put(u8 *dest, u32 value)
+{
+	dest[0] = u8(value);
+	dest[1] = u8(value >> 8);
+	dest[2] = u8(value >> 16);
+	dest[3] = u8(value >> 24);
+}
+
+
+//-------------------------------------------------
+//  netplay_owner - return the player whose
+//  input drives a digital field, or -1 if the
+//  field isn't a player input
+//-------------------------------------------------
+
+int netplay_owner(const ioport_field &field)
+{
+	// start and coin inputs belong to the player with the same number
+	if (field.type() >= IPT_START1 && field.type() <= IPT_START10)
+		return field.type() - IPT_START1;
+	if (field.type() >= IPT_COIN1 && field.type() <= IPT_COIN12)
+		return field.type() - IPT_COIN1;
+	if (field.type_class() == INPUT_CLASS_CONTROLLER && !field.is_analog())
+		return field.player();
+	return -1;
+}
+
+} // anonymous namespace
+
+
+// ======================> ioport_netplay
+
+class ioport_netplay
+{
+public:
+	// construction/destruction
+	ioport_netplay(ioport_manager &manager, int player, int maxframes);
+	~ioport_netplay();
+
+	// getters
+	bool active() const { return !m_failed; }
+	bool resimulating() const { return m_frame < m_resim_target; }
+
+	// per-frame hooks
+	void frame_begin();
+	void update_port(ioport_port &port, int index);
+	void frame_end();
+	void timeslice_end();
+
+private:
+	// history entry for one frame, indexed by frame number modulo the history length
+	struct frame_slot
+	{
+		u32                         frame = ~u32(0);        // frame whose state and local input are held
+		u32                         remote_frame = ~u32(0); // frame whose remote input is held
+		bool                        confirmed = false;      // remote input was received rather than predicted
+		bool                        saved = false;          // state holds the start of the frame
+		std::vector<ioport_value>   local;                  // local input applied to the frame
+		std::vector<ioport_value>   remote;                 // remote input applied to the frame
+		std::vector<u8>             state;                  // machine state at the start of the frame
+	};
+
+	// internal helpers
+	running_machine &machine() const { return m_manager.machine(); }
+	frame_slot &slot(u32 frame) { return m_history[frame % m_history.size()]; }
+
+	void open_lines();
+	void close_lines(const char *reason);
+	void send_packet(u32 type, u32 frame, u32 arg, const ioport_value *values = nullptr);
+	void receive_packets();
+	void handle_packet(const u8 *data);
+	void save_state(frame_slot &entry);
+	void load_state(frame_slot &entry);
+	void rollback(u32 frame);
+	void check_states();
+
+	// internal state
+	ioport_manager &            m_manager;          // reference to the owning manager
+	int                         m_player;           // local player (0-based)
+	u32                         m_max_frames;       // maximum number of frames to run ahead of the peer
+	std::string                 m_localhost;        // socket to listen on
+	std::string                 m_remotehost;       // socket to connect to
+	osd_file::ptr               m_line_rx;          // incoming link
+	osd_file::ptr               m_line_tx;          // outgoing link
+	std::vector<u8>             m_rxbuf;            // bytes received but not yet parsed
+	std::vector<u8>             m_txbuf;            // packet being sent
+	u32                         m_packet_size;      // size of every packet on the link
+	u32                         m_layout;           // checksum of the port layout, must match the peer's
+	bool                        m_connected;        // peer has said hello
+	bool                        m_failed;           // link lost, inputs revert to local control
+
+	std::vector<ioport_value>   m_local_mask;       // per-port bits driven by the local player
+	std::vector<ioport_value>   m_remote_mask;      // per-port bits driven by the remote player
+	std::vector<ioport_value>   m_last_remote;      // most recent remote input, used for prediction
+	std::vector<frame_slot>     m_history;          // per-frame input and state history
+	std::map<u32, u32>          m_local_checks;     // our state checksums awaiting the peer's
+	std::map<u32, u32>          m_remote_checks;    // peer's state checksums awaiting ours
+	size_t                      m_state_size;       // size of one save state
+
+	u32                         m_frame;            // frame about to be emulated
+	u32                         m_resim_target;     // frame at which live input resumes after a rollback
+	s64                         m_remote_frame;     // newest frame with remote input received (-1 if none)
+	u32                         m_rollback_frame;   // earliest mispredicted frame (~0 if none)
+	u32                         m_pending_save;     // frame whose state is saved at the end of the timeslice (~0 if none)
+	u32                         m_pending_load;     // frame whose state is restored at the end of the timeslice (~0 if none)
+	u32                         m_next_check;       // next frame whose state checksum gets exchanged
+	u32                         m_rollbacks;        // number of rollbacks performed
+	u32                         m_replayed;         // number of frames replayed by rollbacks
+	u32                         m_checks;           // number of state checksums that matched the peer's
+};
+
+
+//-------------------------------------------------
+//  ioport_netplay - constructor
+//-------------------------------------------------
+
+ioport_netplay::ioport_netplay(ioport_manager &manager, int player, int maxframes)
+	: m_manager(manager),
+		m_player(player),
+		m_max_frames(maxframes),
+		m_localhost(util::string_format("socket.%s:%s", manager.machine().options().comm_localhost(), manager.machine().options().comm_localport())),
+		m_remotehost(util::string_format("socket.%s:%s", manager.machine().options().comm_remotehost(), manager.machine().options().comm_remoteport())),
+		m_packet_size(NETPLAY_HEADER_SIZE + 4 * manager.ports().size()),
+		m_layout(0),
+		m_connected(false),
+		m_failed(false),
+		m_state_size(0),
+		m_frame(0),
+		m_resim_target(0),
+		m_remote_frame(-1),
+		m_rollback_frame(~u32(0)),
+		m_pending_save(~u32(0)),
+		m_pending_load(~u32(0)),
+		m_next_check(NETPLAY_CHECK_INTERVAL),
+		m_rollbacks(0),
+		m_replayed(0),
+		m_checks(0)
+{
+	// split the digital bits of every port between the two players
+	int const remote = m_player ^ 1;
+	for (auto &port : m_manager.ports())
+	{
+		ioport_value localmask = 0, remotemask = 0;
+		for (ioport_field &field : port.second->fields())
+		{
+			int const owner = netplay_owner(field);
+			if (owner == m_player)
+				localmask |= field.mask();
+			else if (owner == remote)
+				remotemask |= field.mask();
+		}
+		m_local_mask.push_back(localmask);
+		m_remote_mask.push_back(remotemask);
+	}
+	m_last_remote.resize(m_local_mask.size(), 0);
+	m_txbuf.resize(m_packet_size);
+
+	// both sides must agree on the system and which bits each player drives
+	util::crc32_creator crc;
+	crc.append(machine().system().name, strlen(machine().system().name));
+	for (size_t i = 0; i < m_local_mask.size(); i++)
+	{
+		u8 masks[4];
+		netplay_put(masks, m_local_mask[i] | m_remote_mask[i]);
+		crc.append(masks, sizeof(masks));
+	}
+	m_layout = crc.finish();
+
+	// the history must reach back to the oldest unconfirmed frame and ahead to
+	// remote input arriving for frames we haven't run yet
+	m_history.resize(2 * (m_max_frames + 2));
+	for (frame_slot &entry : m_history)
+	{
+		entry.local.resize(m_local_mask.size(), 0);
+		entry.remote.resize(m_local_mask.size(), 0);
+	}
+}
+
+
+//-------------------------------------------------
+//  ~ioport_netplay - destructor
+//-------------------------------------------------
+
+ioport_netplay::~ioport_netplay()
+{
+	if (m_rollbacks > 0)
+		osd_printf_info("Netplay: %u rollbacks, %u frames replayed\n", m_rollbacks, m_replayed);
+	if (m_checks > 0)
+		osd_printf_info("Netplay: %u state checksums matched\n", m_checks);
+}
+
+
+//-------------------------------------------------
+//  frame_begin - synchronize with the peer and
+//  schedule a rollback if a prediction turned
+//  out wrong
+//-------------------------------------------------
+
+void ioport_netplay::frame_begin()
+{
+	if (m_failed)
+		return;
+
+	if (!m_connected)
+		osd_printf_info("Netplay: waiting for player %d at %s\n", (m_player ^ 1) + 1, m_remotehost);
+
+	// stall while we are too far ahead of the peer; the very first frame
+	// also waits for the peer so that both sides start together
+	bool restored = false;
+	osd_ticks_t const start = osd_ticks();
+	for (;;)
+	{
+		open_lines();
+		receive_packets();
+		if (m_failed)
+			return;
+
+		// go back to the earliest mispredicted frame and replay from there
+		if (m_rollback_frame < m_frame)
+		{
+			rollback(m_rollback_frame);
+			if (m_failed)
+				return;
+			restored = true;
+		}
+		m_rollback_frame = ~u32(0);
+
+		if (m_connected && (resimulating() || (s64(m_frame) - m_remote_frame <= s64(m_max_frames))))
+			break;
+
+		int const timeout = m_connected ? NETPLAY_STALL_TIMEOUT : NETPLAY_CONNECT_TIMEOUT;
+		if (osd_ticks() - start > timeout * osd_ticks_per_second())
+		{
+			close_lines(m_connected ? "Remote player stopped responding" : "Remote player didn't connect");
+			return;
+		}
+		osd_sleep(osd_ticks_per_second() / 1000);
+	}
+
+	// save the state at the start of this frame, unless we are about to restore it
+	frame_slot &entry = slot(m_frame);
+	if (!restored)
+	{
+		entry.frame = m_frame;
+		entry.saved = false;
+		m_pending_save = m_frame;
+	}
+
+	// predict any remote input we don't have yet from the latest we do
+	if ((entry.remote_frame != m_frame) || !entry.confirmed)
+	{
+		entry.remote_frame = m_frame;
+		entry.confirmed = false;
+		entry.remote = m_last_remote;
+	}
+
+	// replayed frames are neither shown nor heard
+	machine().video().set_resimulating(resimulating());
+
+	check_states();
+}
+
+
+//-------------------------------------------------
+//  update_port - replace the digital state of a
+//  port with the inputs of both players
+//-------------------------------------------------
+
+void ioport_netplay::update_port(ioport_port &port, int index)
+{
+	if (m_failed)
+		return;
+
+	// live frames take the local input from the devices; replayed frames reuse it
+	frame_slot &entry = slot(m_frame);
+	if (!resimulating())
+		entry.local[index] = port.live().digital & m_local_mask[index];
+
+	// anything not driven by either player is left inactive so both sides agree
+	port.live().digital = entry.local[index] | entry.remote[index];
+}
+
+
+//-------------------------------------------------
+//  frame_end - send the local input for the
+//  frame and advance
+//-------------------------------------------------
+
+void ioport_netplay::frame_end()
+{
+	if (m_failed)
+		return;
+
+	// replayed frames were sent the first time around
+	if (!resimulating())
+		send_packet(NETPLAY_INPUT, m_frame, 0, &slot(m_frame).local[0]);
+	m_frame++;
+}
+
+
+//-------------------------------------------------
+//  timeslice_end - save or restore the state
+//  chosen by frame_begin now that the scheduler
+//  is between timeslices
+//-------------------------------------------------
+
+void ioport_netplay::timeslice_end()
+{
+	u32 const save = m_pending_save;
+	u32 const load = m_pending_load;
+	m_pending_save = m_pending_load = ~u32(0);
+	if (m_failed)
+		return;
+
+	if (load != ~u32(0))
+		load_state(slot(load));
+	else if (save != ~u32(0))
+		save_state(slot(save));
+}
+
+
+//-------------------------------------------------
+//  open_lines - listen for and connect to the
+//  peer if not done yet
+//-------------------------------------------------
+
+void ioport_netplay::open_lines()
+{
+	std::uint64_t filesize; // unused
+
+	if (!m_line_rx)
+		osd_file::open(m_localhost, OPEN_FLAG_CREATE, m_line_rx, filesize);
+
+	if (!m_line_tx)
+	{
+		osd_file::open(m_remotehost, 0, m_line_tx, filesize);
+		if (m_line_tx)
+			send_packet(NETPLAY_HELLO, m_player, m_layout);
+	}
+}
+
+
+//-------------------------------------------------
+//  close_lines - give up on the peer
+//-------------------------------------------------
+
+void ioport_netplay::close_lines(const char *reason)
+{
+	m_line_rx.reset();
+	m_line_tx.reset();
+	m_failed = true;
+	machine().video().set_resimulating(false);
+
+	osd_printf_error("Netplay: %s\n", reason);
+	machine().popmessage("Netplay Ended\nReason: %s", reason);
+}
+
+
+//-------------------------------------------------
+//  send_packet - send one packet to the peer
+//-------------------------------------------------
+
+void ioport_netplay::send_packet(u32 type, u32 frame, u32 arg, const ioport_value *values)
+{
+	if (!m_line_tx)
+		return;
+
+	std::fill(m_txbuf.begin(), m_txbuf.end(), 0);
+	netplay_put(&m_txbuf[0], type);
+	netplay_put(&m_txbuf[4], frame);
+	netplay_put(&m_txbuf[8], arg);
+	if (values != nullptr)
+		for (size_t i = 0; i < m_local_mask.size(); i++)
+			netplay_put(&m_txbuf[NETPLAY_HEADER_SIZE + 4 * i], values[i]);
+
+	std::uint32_t written = 0;
+	osd_file::error filerr = m_line_tx->write(&m_txbuf[0], 0, m_packet_size, written);
+	if ((filerr != osd_file::error::NONE) || (written != m_packet_size))
+		close_lines("Transmit error");
+}
+
+
+//-------------------------------------------------
+//  receive_packets - drain the incoming link and
+//  handle all complete packets
+//-------------------------------------------------
+
+void ioport_netplay::receive_packets()
+{
+	if (!m_line_rx)
+		return;
+
+	u8 buffer[1024];
+	for (;;)
+	{
+		std::uint32_t recv = 0;
+		osd_file::error filerr = m_line_rx->read(buffer, 0, sizeof(buffer), recv);
+		if (filerr != osd_file::error::NONE)
+		{
+			close_lines("Receive error");
+			return;
+		}
+		if (recv == 0)
+			break;
+		m_rxbuf.insert(m_rxbuf.end(), buffer, buffer + recv);
+	}
+
+	size_t offset = 0;
+	while (!m_failed && (m_rxbuf.size() - offset >= m_packet_size))
+	{
+		handle_packet(&m_rxbuf[offset]);
+		offset += m_packet_size;
+	}
+	m_rxbuf.erase(m_rxbuf.begin(), m_rxbuf.begin() + std::min(offset, m_rxbuf.size()));
+}
+
+
+//-------------------------------------------------
+//  handle_packet - process one packet from the
+//  peer
+//-------------------------------------------------
+
+void ioport_netplay::handle_packet(const u8 *data)
+{
+	u32 const type = netplay_get(&data[0]);
+	u32 const frame = netplay_get(&data[4]);
+	u32 const arg = netplay_get(&data[8]);
+
+	switch (type)
+	{
+	case NETPLAY_HELLO:
+		if ((frame != u32(m_player ^ 1)) || (arg != m_layout))
+		{
+			close_lines("Remote player configuration doesn't match");
+			return;
+		}
+		osd_printf_info("Netplay: connected to player %u\n", frame + 1);
+		m_connected = true;
+		break;
+
+	case NETPLAY_INPUT:
+		{
+			// the link is a stream, so input arrives complete and in order
+			if (s64(frame) != m_remote_frame + 1)
+			{
+				close_lines("Remote input out of sequence");
+				return;
+			}
+			for (size_t i = 0; i < m_last_remote.size(); i++)
+				m_last_remote[i] = netplay_get(&data[NETPLAY_HEADER_SIZE + 4 * i]) & m_remote_mask[i];
+			m_remote_frame = frame;
+
+			// if this frame already ran on a wrong guess, it has to run again
+			frame_slot &entry = slot(frame);
+			if ((frame < m_frame) && (entry.remote_frame == frame) && (entry.remote != m_last_remote))
+				m_rollback_frame = std::min(m_rollback_frame, frame);
+			entry.remote_frame = frame;
+			entry.confirmed = true;
+			entry.remote = m_last_remote;
+		}
+		break;
+
+	case NETPLAY_CHECK:
+		m_remote_checks[frame] = arg;
+		break;
+
+	default:
+		close_lines("Unknown packet from remote player");
+		break;
+	}
+}
+
+
+//-------------------------------------------------
+//  save_state - capture the machine state at the
+//  start of a frame
+//-------------------------------------------------
+
+void ioport_netplay::save_state(frame_slot &entry)
+{
+	// anonymous timers aren't part of the state, so skip this frame; a
+	// rollback to it will go back to an earlier frame instead
+	if (!machine().scheduler().can_save())
+		return;
+
+	// registrations are complete by the time the first frame runs
+	if (m_state_size == 0)
+		m_state_size = ram_state::get_size(machine().save());
+
+	entry.state.resize(m_state_size);
+	if (machine().save().write_buffer(&entry.state[0], m_state_size) != STATERR_NONE)
+	{
+		close_lines("Unable to save machine state");
+		return;
+	}
+	entry.saved = true;
+}
+
+
+//-------------------------------------------------
+//  load_state - restore the machine state at the
+//  start of a frame
+//-------------------------------------------------
+
+void ioport_netplay::load_state(frame_slot &entry)
+{
+	assert(entry.saved);
+	if (machine().save().read_buffer(&entry.state[0], entry.state.size()) != STATERR_NONE)
+		close_lines("Unable to restore machine state");
+}
+
+
+//-------------------------------------------------
+//  rollback - arrange for the state at the start
+//  of a frame to be restored so it can be
+//  replayed
+//-------------------------------------------------
+
+void ioport_netplay::rollback(u32 frame)
+{
+	// go back further if the frame's state couldn't be saved
+	while ((slot(frame).frame != frame) || !slot(frame).saved)
+	{
+		if ((frame == 0) || (m_frame - frame >= m_history.size()))
+		{
+			close_lines("No machine state to roll back to");
+			return;
+		}
+		frame--;
+	}
+
+	// replay up to where we were, or further if already replaying
+	m_resim_target = std::max(m_resim_target, m_frame);
+	m_replayed += m_frame - frame;
+	m_rollbacks++;
+	m_frame = frame;
+	m_pending_load = frame;
+}
+
+
+//-------------------------------------------------
+//  check_states - exchange checksums of states
+//  that can no longer change and compare them
+//-------------------------------------------------
+
+void ioport_netplay::check_states()
+{
+	// a state is final once the remote input for every earlier frame is
+	// known; the current frame's state isn't saved until the timeslice ends
+	while ((m_next_check < m_frame) && (s64(m_next_check) <= m_remote_frame + 1))
+	{
+		frame_slot &entry = slot(m_next_check);
+		if ((entry.frame == m_next_check) && entry.saved)
+		{
+			u32 const crc = util::crc32_creator::simple(&entry.state[0], entry.state.size());
+			m_local_checks[m_next_check] = crc;
+			send_packet(NETPLAY_CHECK, m_next_check, crc);
+		}
+		m_next_check += NETPLAY_CHECK_INTERVAL;
+	}
+
+	// compare whatever both sides have reported
+	for (auto it = m_local_checks.begin(); it != m_local_checks.end(); )
+	{
+		auto const remote = m_remote_checks.find(it->first);
+		if (remote == m_remote_checks.end())
+		{
+			++it;
+			continue;
+		}
+		if (remote->second != it->second)
+		{
+			osd_printf_error("Netplay: desync detected at frame %u\n", it->first);
+			machine().popmessage("Netplay desync at frame %u", it->first);
+		}
+		else
+		{
+			osd_printf_verbose("Netplay: state at frame %u matches (%08X)\n", it->first, it->second);
+			m_checks++;
+		}
+		m_remote_checks.erase(remote);
+		it = m_local_checks.erase(it);
+	}
+}
+
+
+
 //**************************************************************************
 //  I/O PORT MANAGER
 //**************************************************************************
@@ -1882,6 +2520,7 @@ time_t ioport_manager::initialize()
 	time_t basetime = playback_init();
 	record_init();
 	timecode_init();
+	netplay_init();
 	return basetime;
 }
 
@@ -1964,6 +2603,7 @@ void ioport_manager::exit()
 	playback_end();
 	record_end();
 	timecode_end();
+	netplay_end();
 }
 
 
@@ -2122,6 +2762,12 @@ void ioport_manager::frame_update_callback()
 void ioport_manager::frame_update()
 {
 	g_profiler.start(PROFILER_INPUT);
+	PERF_TRACE_SCOPE("ioport_manager::frame_update");
+
+	// netplay may switch to replaying an earlier frame before anything else looks at the inputs
+	bool const netplay = m_netplay && m_netplay->active() && (machine().phase() == machine_phase::RUNNING);
+	if (netplay)
+		m_netplay->frame_begin();
 
 	// record/playback information about the current frame
 	attotime curtime = machine().time();
@@ -2144,6 +2790,7 @@ void ioport_manager::frame_update()
 		port.second->update_defvalue(false);
 
 	// loop over all input ports
+	int portnum = 0;
 	for (auto &port : m_portlist)
 	{
 		/* now loop back and modify based on the inputs */
@@ -2169,6 +2816,11 @@ void ioport_manager::frame_update()
 		playback_port(*port.second.get());
 		record_port(*port.second.get());
 
+		// merge in the remote player's input
+		if (netplay)
+			m_netplay->update_port(*port.second.get(), portnum);
+		portnum++;
+
 		// call device line write handlers
 		ioport_value newvalue = port.second->read();
 		for (dynamic_field &dynfield : port.second->live().writelist)
@@ -2176,6 +2828,9 @@ void ioport_manager::frame_update()
 				dynfield.write(newvalue);
 	}
 
+	if (netplay)
+		m_netplay->frame_end();
+
 	g_profiler.stop();
 }
 
@@ -3176,6 +3831,68 @@ void ioport_manager::record_port(ioport_port &port)
 
 
 
+//-------------------------------------------------
+//  netplay_init - start a rollback netplay
+//  session if requested
+//-------------------------------------------------
+
+void ioport_manager::netplay_init()
+{
+	if (!machine().options().comm_rollback())
+		return;
+
+	// replayed frames would end up in the recording twice
+	if (m_record_file.is_open() || m_playback_file.is_open())
+	{
+		osd_printf_warning("Rollback netplay is not available while recording or playing back input\n");
+		return;
+	}
+
+	int const player = machine().options().comm_player();
+	if ((player < 1) || (player > 2))
+	{
+		osd_printf_error("Rollback netplay supports players 1 and 2 only\n");
+		return;
+	}
+
+	// only digital inputs are exchanged, so an analog control would desync
+	for (auto &port : m_portlist)
+		for (ioport_field &field : port.second->fields())
+			if (field.is_analog() && field.enabled())
+			{
+				osd_printf_error("Rollback netplay does not support analog inputs (port %s)\n", port.first);
+				return;
+			}
+
+	m_netplay = std::make_unique<ioport_netplay>(*this, player - 1, machine().options().comm_rollback_frames());
+}
+
+
+//-------------------------------------------------
+//  handle_netplay - save or restore the machine
+//  state for rollback netplay; called by the
+//  machine between timeslices, where deferred
+//  save state loads are handled
+//-------------------------------------------------
+
+void ioport_manager::handle_netplay()
+{
+	if (m_netplay)
+		m_netplay->timeslice_end();
+}
+
+
+//-------------------------------------------------
+//  netplay_end - end the rollback netplay session
+//-------------------------------------------------
+
+void ioport_manager::netplay_end()
+{
+	m_netplay.reset();
+}
+
+
+
 //**************************************************************************
 //  I/O PORT CONFIGURER
 //**************************************************************************
@@ -1390,6 +1390,8 @@ struct ioport_port_live
 
 // ======================> ioport_manager
 
+class ioport_netplay;
+
 // private input port state
 class ioport_manager
 {
@@ -1429,6 +1431,9 @@ public:
 	void set_autofiredelay(int player, int delay) { m_autofiredelay[player] = delay; };
 	u16 m_custom_button[MAX_PLAYERS][MAX_CUSTOM_BUTTONS];
 
+	// rollback netplay
+	void handle_netplay();
+
 private:
 	// internal helpers
 	void init_port_types();
@@ -1469,6 +1474,9 @@ private:
 	void timecode_init();
 	void timecode_end(const char *message = nullptr);
 
+	void netplay_init();
+	void netplay_end();
+
 	// internal state
 	running_machine &       m_machine;              // reference to owning machine
 	bool                    m_safe_to_read;         // clear at start; set after state is loaded
@@ -1496,6 +1504,9 @@ private:
 	emu_file                m_timecode_file;        // timecode/frames playback file (nullptr if not recording)
 	int                     m_timecode_count;
 	attotime                m_timecode_last_time;
+
+	// rollback netplay
+	std::unique_ptr<ioport_netplay> m_netplay;      // netplay session (nullptr if not linked)
 };
 
 
@@ -0,0 +1,82 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    parallel.h
+
+    Split a one-off loop, such as decrypting a ROM at startup, across the
+    OSD work queue.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __EMU_H__
+#error Dont include this file directly; include emu.h instead.
+#endif
+
+#ifndef MAME_EMU_PARALLEL_H
+#define MAME_EMU_PARALLEL_H
+
+#include "osdsync.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+
+//**************************************************************************
+//  FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  parallel_for - call fn(start, end) on slices
+//  of [0, count), each at least min_share long
+//  where possible; the slices run on a
+//  multi-threaded work queue, which sizes itself
+//  from -numprocessors, and this returns once
+//  they are all done
+//-------------------------------------------------
+
+template <typename Func>
+void parallel_for(u32 count, u32 min_share, Func &&fn)
+{
+	// a few slices per processor keeps the threads busy when slices take uneven time
+	constexpr u32 MAX_SLICES = 64;
+
+	struct slice
+	{
+		static void *execute(void *param, int threadid)
+		{
+			slice &s = *reinterpret_cast<slice *>(param);
+			(*s.fn)(s.start, s.end);
+			return nullptr;
+		}
+
+		std::remove_reference_t<Func> *fn;
+		u32 start;
+		u32 end;
+	};
+
+	u32 const slices = std::clamp<u32>(count / std::max<u32>(min_share, 1), 1, MAX_SLICES);
+	osd_work_queue *const queue = (slices > 1) ? osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI) : nullptr;
+	if (queue == nullptr)
+	{
+		fn(0, count);
+		return;
+	}
+
+	std::vector<slice> work(slices);
+	for (u32 i = 0; i < slices; i++)
+	{
+		work[i].fn = &fn;
+		work[i].start = u64(count) * i / slices;
+		work[i].end = u64(count) * (i + 1) / slices;
+	}
+
+	osd_work_item_queue_multiple(queue, &slice::execute, slices, &work[0], sizeof(slice), WORK_ITEM_FLAG_AUTO_RELEASE);
+	osd_work_queue_wait(queue, osd_ticks_per_second() * 100);
+	osd_work_queue_free(queue);
+}
+
+#endif // MAME_EMU_PARALLEL_H
@@ -0,0 +1,167 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    perftrace.cpp
+
+    Lightweight scoped timing events, exported as Chrome trace JSON.
+
+    Each thread that records an event gets its own fixed-size ring, so
+    recording never takes a lock after the first event on a thread. When
+    a ring fills, the oldest events are overwritten. The collected events
+    are written on stop() in the Trace Event Format understood by
+    chrome://tracing and Perfetto.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "perftrace.h"
+
+#include "corefile.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+namespace {
+
+struct trace_event
+{
+	const char *    name;
+	const char *    detail;
+	osd_ticks_t     start;
+	osd_ticks_t     end;
+};
+
+struct thread_ring
+{
+	// number of events kept per thread (must be a power of two)
+	static constexpr u32 SIZE = 1 << 16;
+
+	thread_ring(u32 id) : tid(id), head(0), events(SIZE) { }
+
+	u32                     tid;        // thread number written to the trace
+	std::atomic<u64>        head;       // total events recorded since start()
+	std::vector<trace_event> events;    // the ring itself
+};
+
+
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+// rings are never freed, since threads may still hold a pointer to theirs
+std::mutex                                  s_rings_lock;
+std::vector<std::unique_ptr<thread_ring> >  s_rings;
+std::string                                 s_filename;
+osd_ticks_t                                 s_origin;
+
+thread_local thread_ring *                  t_ring = nullptr;
+
+} // anonymous namespace
+
+
+std::atomic<bool> perf_trace::s_enabled(false);
+
+
+
+//**************************************************************************
+//  PERF TRACE
+//**************************************************************************
+
+//-------------------------------------------------
+//  start - begin collecting events
+//-------------------------------------------------
+
+void perf_trace::start(const char *filename)
+{
+	std::lock_guard<std::mutex> lock(s_rings_lock);
+	for (auto &ring : s_rings)
+		ring->head.store(0, std::memory_order_relaxed);
+	s_filename = filename;
+	s_origin = osd_ticks();
+	s_enabled.store(true, std::memory_order_release);
+}
+
+
+//-------------------------------------------------
+//  add - record one completed event on the
+//  calling thread's ring
+//-------------------------------------------------
+
+void perf_trace::add(const char *name, const char *detail, osd_ticks_t start, osd_ticks_t end)
+{
+	thread_ring *ring = t_ring;
+	if (!ring)
+	{
+		std::lock_guard<std::mutex> lock(s_rings_lock);
+		s_rings.emplace_back(std::make_unique<thread_ring>(s_rings.size()));
+		ring = t_ring = s_rings.back().get();
+	}
+
+	const u64 head = ring->head.load(std::memory_order_relaxed);
+	ring->events[head & (thread_ring::SIZE - 1)] = trace_event{ name, detail, start, end };
+	ring->head.store(head + 1, std::memory_order_release);
+}
+
+
+//-------------------------------------------------
+//  stop - stop collecting and write everything
+//  out as Chrome trace JSON
+//-------------------------------------------------
+
+void perf_trace::stop()
+{
+	if (!s_enabled.exchange(false, std::memory_order_acq_rel))
+		return;
+
+	std::lock_guard<std::mutex> lock(s_rings_lock);
+	util::core_file::ptr file;
+	if (util::core_file::open(s_filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, file) != osd_file::error::NONE)
+	{
+		osd_printf_error("Unable to open performance trace file %s\n", s_filename);
+		return;
+	}
+
+	const double usec_per_tick = 1000000.0 / double(osd_ticks_per_second());
+	u64 total = 0, dropped = 0;
+	bool first = true;
+
+	file->puts("{\"traceEvents\":[\n");
+	for (auto &ring : s_rings)
+	{
+		// name the thread so the viewer groups its events sensibly
+		file->printf("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+				first ? "" : ",\n", ring->tid, ring->tid);
+		first = false;
+
+		const u64 head = ring->head.load(std::memory_order_acquire);
+		const u64 count = std::min<u64>(head, thread_ring::SIZE);
+		dropped += head - count;
+		for (u64 index = head - count; index < head; index++)
+		{
+			const trace_event &event = ring->events[index & (thread_ring::SIZE - 1)];
+			if (event.start < s_origin)
+				continue;
+
+			file->printf(",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+					event.name, ring->tid,
+					double(event.start - s_origin) * usec_per_tick,
+					double(event.end - event.start) * usec_per_tick);
+			if (event.detail)
+				file->printf(",\"args\":{\"tag\":\"%s\"}", event.detail);
+			file->puts("}");
+			total++;
+		}
+	}
+	file->puts("\n]}\n");
+
+	osd_printf_info("Wrote %u performance trace events to %s (%u overwritten)\n", total, s_filename, dropped);
+}
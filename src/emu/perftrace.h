@@ -0,0 +1,85 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    perftrace.h
+
+    Lightweight scoped timing events, exported as Chrome trace JSON.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __EMU_H__
+#error Dont include this file directly; include emu.h instead.
+#endif
+
+#ifndef MAME_EMU_PERFTRACE_H
+#define MAME_EMU_PERFTRACE_H
+
+#include <atomic>
+
+
+//**************************************************************************
+//  MACROS
+//**************************************************************************
+
+#define PERF_TRACE_CONCAT_(a, b)        a##b
+#define PERF_TRACE_CONCAT(a, b)         PERF_TRACE_CONCAT_(a, b)
+
+// time the rest of the enclosing scope; name and detail must outlive the trace
+#define PERF_TRACE_SCOPE(...)           perf_trace_scope PERF_TRACE_CONCAT(perf_trace_scope_, __LINE__)(__VA_ARGS__)
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> perf_trace
+
+class perf_trace
+{
+public:
+	// start collecting events; they are written to the given file by stop()
+	static void start(const char *filename);
+	static void stop();
+
+	// getters
+	static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+	// record a completed event on the calling thread
+	static void add(const char *name, const char *detail, osd_ticks_t start, osd_ticks_t end);
+
+private:
+	static std::atomic<bool> s_enabled;
+};
+
+
+// ======================> perf_trace_scope
+
+class perf_trace_scope
+{
+public:
+	perf_trace_scope(const char *name, const char *detail = nullptr)
+		: m_name(perf_trace::enabled() ? name : nullptr)
+		, m_detail(detail)
+		, m_start(m_name ? osd_ticks() : 0)
+	{
+	}
+
+	~perf_trace_scope()
+	{
+		if (m_name)
+			perf_trace::add(m_name, m_detail, m_start, osd_ticks());
+	}
+
+	perf_trace_scope(const perf_trace_scope &) = delete;
+	perf_trace_scope &operator=(const perf_trace_scope &) = delete;
+
+private:
+	const char *    m_name;         // event name, or nullptr if not tracing
+	const char *    m_detail;       // optional argument (e.g. device tag)
+	osd_ticks_t     m_start;        // ticks at construction
+};
+
+#endif // MAME_EMU_PERFTRACE_H
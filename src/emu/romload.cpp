@@ -13,6 +13,7 @@
 
 #include "corestr.h"
 #include "emuopts.h"
+#include "perftrace.h"
 #include "drivenum.h"
 #include "softlist_dev.h"
 #include "ui/uimain.h"
@@ -504,6 +505,8 @@ void rom_load_manager::dump_wrong_and_correct_checksums(const util::hash_collect
 
 void rom_load_manager::verify_length_and_hash(emu_file *file, std::string_view name, u32 explength, const util::hash_collection &hashes)
 {
+	PERF_TRACE_SCOPE("rom_load_manager::verify_length_and_hash");
+
 	// we've already complained if there is no file
 	if (!file)
 		return;
@@ -598,6 +601,8 @@ void rom_load_manager::display_rom_load_results(bool from_list)
 
 void rom_load_manager::region_post_process(memory_region *region, bool invert)
 {
+	PERF_TRACE_SCOPE("rom_load_manager::region_post_process");
+
 	// do nothing if no region
 	if (region == nullptr)
 		return;
@@ -897,6 +902,8 @@ void rom_load_manager::copy_rom_data(const rom_entry *romp)
 
 void rom_load_manager::process_rom_entries(std::initializer_list<std::reference_wrapper<const std::vector<std::string> > > searchpath, u8 bios, const rom_entry *parent_region, const rom_entry *romp, bool from_list)
 {
+	PERF_TRACE_SCOPE("rom_load_manager::process_rom_entries");
+
 	u32 lastflags = 0;
 	std::vector<std::string> tried_file_names;
 
@@ -1048,6 +1055,8 @@ chd_error rom_load_manager::open_disk_diff(emu_options &options, const rom_entry
 
 void rom_load_manager::process_disk_entries(std::initializer_list<std::reference_wrapper<const std::vector<std::string> > > searchpath, std::string_view regiontag, const rom_entry *romp, std::function<const rom_entry * ()> next_parent)
 {
+	PERF_TRACE_SCOPE("rom_load_manager::process_disk_entries");
+
 	/* remove existing disk entries for this region */
 	m_chd_list.erase(std::remove_if(m_chd_list.begin(), m_chd_list.end(),
 			[regiontag] (std::unique_ptr<open_chd> &chd) { return chd->region() == regiontag; }), m_chd_list.end());
@@ -1334,6 +1343,8 @@ void rom_load_manager::load_software_part_region(device_t &device, software_list
 
 void rom_load_manager::process_region_list()
 {
+	PERF_TRACE_SCOPE("rom_load_manager::process_region_list");
+
 	// loop until we hit the end
 	device_enumerator deviter(machine().root_device());
 	std::vector<std::string> searchpath;
@@ -1431,6 +1442,10 @@ rom_load_manager::rom_load_manager(running_machine &machine)
 	, m_errorstring()
 	, m_softwarningstring()
 {
+	// the ROM loader runs early enough that starting the trace here covers it
+	if (*machine.options().perftrace())
+		perf_trace::start(machine.options().perftrace());
+
 	// figure out which BIOS we are using
 	std::map<std::string_view, std::string> card_bios;
 	for (device_t &device : device_enumerator(machine.config().root_device()))
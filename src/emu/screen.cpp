@@ -12,6 +12,7 @@
 #include "screen.h"
 
 #include "emuopts.h"
+#include "perftrace.h"
 #include "render.h"
 #include "rendutil.h"
 
@@ -1197,6 +1198,7 @@ bool screen_device::update_partial(int scanline)
 	// otherwise, render
 	LOG_PARTIAL_UPDATES(("updating %d-%d\n", clip.top(), clip.bottom()));
 	g_profiler.start(PROFILER_VIDEO);
+	PERF_TRACE_SCOPE("screen_device::update_partial", tag());
 
 	u32 flags = 0;
 	if (m_video_attributes & VIDEO_VARIABLE_WIDTH)
@@ -15,6 +15,7 @@
 #include "crsshair.h"
 #include "rendersw.hxx"
 #include "output.h"
+#include "perftrace.h"
 
 #include "corestr.h"
 #include "png.h"
@@ -22,6 +23,12 @@
 
 #include "osdepend.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -54,6 +61,174 @@ const bool video_manager::s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS] =
 
 
 
+//**************************************************************************
+//  SNAPSHOT ENCODER
+//**************************************************************************
+
+// ======================> video_manager::snapshot_encoder
+
+// copies of snapshot bitmaps are handed to a small pool of worker threads
+// which do the PNG compression and file output; the files are opened (and
+// therefore named) on the emulation thread, so numbering is unaffected
+class video_manager::snapshot_encoder
+{
+public:
+	// construction/destruction
+	snapshot_encoder(std::string &&software, std::string &&system);
+	~snapshot_encoder();
+
+	// queue a bitmap for writing; blocks if too many are outstanding
+	void submit(std::unique_ptr<emu_file> &&file, const bitmap_rgb32 &bitmap, const rgb_t *palette, int entries);
+
+private:
+	// maximum number of bitmaps held in the pool
+	static constexpr unsigned MAX_JOBS = 8;
+
+	// maximum number of encoding threads
+	static constexpr unsigned MAX_THREADS = 2;
+
+	struct job
+	{
+		std::unique_ptr<emu_file>   file;       // destination, already opened
+		bitmap_rgb32                bitmap;     // copy of the snapshot bitmap
+		std::vector<rgb_t>          palette;    // copy of the screen palette
+	};
+
+	void thread_proc();
+
+	// internal state
+	std::string                         m_software;     // "Software" PNG text entry
+	std::string                         m_system;       // "System" PNG text entry
+	std::mutex                          m_lock;         // protects everything below
+	std::condition_variable             m_work_cond;    // signalled when work is queued
+	std::condition_variable             m_done_cond;    // signalled when a job completes
+	std::deque<std::unique_ptr<job> >   m_pending;      // jobs waiting for a thread
+	std::vector<std::unique_ptr<job> >  m_free;         // recycled jobs (bitmaps stay allocated)
+	unsigned                            m_allocated;    // total jobs allocated
+	bool                                m_exit;         // tells the threads to finish
+	std::vector<std::thread>            m_threads;      // worker threads
+};
+
+
+//-------------------------------------------------
+//  snapshot_encoder - constructor
+//-------------------------------------------------
+
+video_manager::snapshot_encoder::snapshot_encoder(std::string &&software, std::string &&system)
+	: m_software(std::move(software))
+	, m_system(std::move(system))
+	, m_allocated(0)
+	, m_exit(false)
+{
+	const unsigned count = std::max(1U, std::min(MAX_THREADS, std::thread::hardware_concurrency() / 2));
+	for (unsigned i = 0; i < count; i++)
+		m_threads.emplace_back([this] () { thread_proc(); });
+}
+
+
+//-------------------------------------------------
+//  ~snapshot_encoder - finish all outstanding
+//  work and stop the threads
+//-------------------------------------------------
+
+video_manager::snapshot_encoder::~snapshot_encoder()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_exit = true;
+	}
+	m_work_cond.notify_all();
+	for (std::thread &thread : m_threads)
+		thread.join();
+}
+
+
+//-------------------------------------------------
+//  submit - copy a bitmap and queue it for
+//  writing to the given file
+//-------------------------------------------------
+
+void video_manager::snapshot_encoder::submit(std::unique_ptr<emu_file> &&file, const bitmap_rgb32 &bitmap, const rgb_t *palette, int entries)
+{
+	// grab a free job, allocating or waiting for one as necessary
+	std::unique_ptr<job> current;
+	{
+		std::unique_lock<std::mutex> lock(m_lock);
+		if (m_free.empty() && m_allocated >= MAX_JOBS)
+			m_done_cond.wait(lock, [this] () { return !m_free.empty(); });
+		if (!m_free.empty())
+		{
+			current = std::move(m_free.back());
+			m_free.pop_back();
+		}
+		else
+		{
+			m_allocated++;
+		}
+	}
+	if (!current)
+		current = std::make_unique<job>();
+
+	// copy the image data while the caller's bitmap is still valid
+	if (current->bitmap.width() != bitmap.width() || current->bitmap.height() != bitmap.height())
+		current->bitmap.resize(bitmap.width(), bitmap.height());
+	for (int y = 0; y < bitmap.height(); y++)
+		std::copy_n(&bitmap.pix(y), bitmap.width(), &current->bitmap.pix(y));
+	if (palette != nullptr)
+		current->palette.assign(palette, palette + entries);
+	else
+		current->palette.clear();
+	current->file = std::move(file);
+
+	// hand it to a worker
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_pending.emplace_back(std::move(current));
+	}
+	m_work_cond.notify_one();
+}
+
+
+//-------------------------------------------------
+//  thread_proc - encode snapshots until told to
+//  exit with nothing left in the queue
+//-------------------------------------------------
+
+void video_manager::snapshot_encoder::thread_proc()
+{
+	for (;;)
+	{
+		std::unique_ptr<job> current;
+		{
+			std::unique_lock<std::mutex> lock(m_lock);
+			m_work_cond.wait(lock, [this] () { return m_exit || !m_pending.empty(); });
+			if (m_pending.empty())
+				return;
+			current = std::move(m_pending.front());
+			m_pending.pop_front();
+		}
+
+		// this matches save_snapshot exactly, so the output is identical
+		util::png_info pnginfo;
+		pnginfo.add_text("Software", m_software);
+		pnginfo.add_text("System", m_system);
+		const int entries = current->palette.size();
+		util::png_error error = util::png_write_bitmap(*current->file, &pnginfo, current->bitmap, entries, entries ? &current->palette[0] : nullptr);
+		if (error != util::png_error::NONE)
+			osd_printf_error("Error generating PNG for snapshot: png_error = %d\n", std::underlying_type_t<util::png_error>(error));
+		current->file.reset();
+
+		// recycle the job
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_free.emplace_back(std::move(current));
+		}
+		m_done_cond.notify_all();
+	}
+}
+
+
+
 //**************************************************************************
 //  VIDEO MANAGER
 //**************************************************************************
@@ -99,11 +274,14 @@ video_manager::video_manager(running_machine &machine)
 	, m_frameskip_counter(0)
 	, m_frameskip_adjust(0)
 	, m_skipping_this_frame(false)
+	, m_resimulating(false)
 	, m_average_oversleep(0)
 	, m_snap_target(nullptr)
 	, m_snap_native(true)
 	, m_snap_width(0)
 	, m_snap_height(0)
+	, m_snap_sequence(std::max(machine.options().snap_sequence(), 0))
+	, m_snap_sequence_frame(0)
 	, m_timecode_enabled(false)
 	, m_timecode_write(false)
 	, m_timecode_text("")
@@ -180,6 +358,15 @@ video_manager::video_manager(running_machine &machine)
 }
 
 
+//-------------------------------------------------
+//  ~video_manager - destructor
+//-------------------------------------------------
+
+video_manager::~video_manager()
+{
+}
+
+
 //-------------------------------------------------
 //  set_frameskip - set the current actual
 //  frameskip (-1 means autoframeskip)
@@ -211,9 +398,11 @@ void video_manager::set_frameskip(int frameskip)
 
 void video_manager::frame_update(bool from_debugger)
 {
+	PERF_TRACE_SCOPE("video_manager::frame_update");
+
 	// only render sound and video if we're in the running phase
 	machine_phase const phase = machine().phase();
-	bool skipped_it = m_skipping_this_frame;
+	bool skipped_it = m_skipping_this_frame || m_resimulating;
 	if (phase == machine_phase::RUNNING && (!machine().paused() || machine().options().update_in_pause()))
 	{
 		bool anything_changed = finish_screen_updates();
@@ -346,12 +535,41 @@ void video_manager::save_snapshot(screen_device *screen, emu_file &file)
 }
 
 
+//-------------------------------------------------
+//  queue_snapshot - render a snapshot and hand it
+//  to the background encoder; the file must
+//  already be open
+//-------------------------------------------------
+
+void video_manager::queue_snapshot(screen_device *screen, std::unique_ptr<emu_file> &&file)
+{
+	// validate
+	assert(!m_snap_native || screen != nullptr);
+
+	// create the bitmap to pass in
+	create_snapshot_bitmap(screen);
+
+	// start the encoder the first time through
+	if (!m_snap_encoder)
+	{
+		std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
+		std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().type.fullname());
+		m_snap_encoder = std::make_unique<snapshot_encoder>(std::move(text1), std::move(text2));
+	}
+
+	// the encoder takes a copy, so m_snap_bitmap is free for reuse on return
+	const rgb_t *palette = (screen != nullptr && screen->has_palette()) ? screen->palette().palette()->entry_list_adjusted() : nullptr;
+	int entries = (screen != nullptr && screen->has_palette()) ? screen->palette().entries() : 0;
+	m_snap_encoder->submit(std::move(file), m_snap_bitmap, palette, entries);
+}
+
+
 //-------------------------------------------------
 //  save_active_screen_snapshots - save a
 //  snapshot of all active screens
 //-------------------------------------------------
 
-void video_manager::save_active_screen_snapshots()
+void video_manager::save_active_screen_snapshots(bool background)
 {
 	if (m_snap_native)
 	{
@@ -359,19 +577,57 @@ void video_manager::save_active_screen_snapshots()
 		for (screen_device &screen : screen_device_enumerator(machine().root_device()))
 			if (machine().render().is_live(screen))
 			{
-				emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-				osd_file::error filerr = open_next(file, "png");
-				if (filerr == osd_file::error::NONE)
-					save_snapshot(&screen, file);
+				auto file = std::make_unique<emu_file>(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+				osd_file::error filerr = open_next(*file, "png");
+				if (filerr != osd_file::error::NONE)
+					continue;
+				if (background)
+					queue_snapshot(&screen, std::move(file));
+				else
+					save_snapshot(&screen, *file);
 			}
 	}
 	else
 	{
 		// otherwise, just write a single snapshot
-		emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-		osd_file::error filerr = open_next(file, "png");
-		if (filerr == osd_file::error::NONE)
-			save_snapshot(nullptr, file);
+		auto file = std::make_unique<emu_file>(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		osd_file::error filerr = open_next(*file, "png");
+		if (filerr != osd_file::error::NONE)
+			return;
+		if (background)
+			queue_snapshot(nullptr, std::move(file));
+		else
+			save_snapshot(nullptr, *file);
+	}
+}
+
+
+//-------------------------------------------------
+//  save_sequence_snapshots - write the current
+//  frame as part of a PNG sequence; names come
+//  from the frame count rather than a directory
+//  scan so that every frame costs the same
+//-------------------------------------------------
+
+void video_manager::save_sequence_snapshots()
+{
+	const u32 frame = (m_snap_sequence_frame - 1) / m_snap_sequence;
+	int index = 0;
+	for (screen_device &screen : screen_device_enumerator(machine().root_device()))
+	{
+		if (m_snap_native && !machine().render().is_live(screen))
+			continue;
+
+		std::string name = m_snap_native
+				? string_format("%s" PATH_SEPARATOR "seq%d_%08u.png", machine().basename(), index++, frame)
+				: string_format("%s" PATH_SEPARATOR "seq_%08u.png", machine().basename(), frame);
+		auto file = std::make_unique<emu_file>(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		if (file->open(name) == osd_file::error::NONE)
+			queue_snapshot(m_snap_native ? &screen : nullptr, std::move(file));
+
+		// a single composite snapshot covers every screen
+		if (!m_snap_native)
+			break;
 	}
 }
 
@@ -516,6 +772,12 @@ void video_manager::exit()
 	// stop recording any movie
 	m_movie_recordings.clear();
 
+	// finish writing any queued snapshots
+	m_snap_encoder.reset();
+
+	// write out the performance trace, if any
+	perf_trace::stop();
+
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
@@ -658,6 +920,10 @@ bool video_manager::finish_screen_updates()
 	{
 		record_frame();
 
+		// dump every Nth frame when a PNG sequence is requested
+		if (m_snap_sequence != 0 && (m_snap_sequence_frame++ % m_snap_sequence) == 0)
+			save_sequence_snapshots();
+
 		// iterate over screens and update the burnin for the ones that care
 		for (screen_device &screen : iter)
 			screen.update_burnin();
@@ -42,16 +42,18 @@ class video_manager
 public:
 	// construction/destruction
 	video_manager(running_machine &machine);
+	~video_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
-	bool skip_this_frame() const { return m_skipping_this_frame; }
+	bool skip_this_frame() const { return m_skipping_this_frame || m_resimulating; }
 	int speed_factor() const { return m_speed; }
 	int frameskip() const { return m_auto_frameskip ? -1 : m_frameskip_level; }
 	bool throttled() const { return m_throttled; }
 	bool sync_refresh() const { return m_syncrefresh; }
 	float throttle_rate() const { return m_throttle_rate; }
 	bool fastforward() const { return m_fastforward; }
+	bool resimulating() const { return m_resimulating; }
 
 	// setters
 	void set_frameskip(int frameskip);
@@ -59,6 +61,7 @@ public:
 	void set_throttle_rate(float throttle_rate) { m_throttle_rate = throttle_rate; }
 	void set_fastforward(bool ffwd) { m_fastforward = ffwd; }
 	void set_output_changed() { m_output_changed = true; }
+	void set_resimulating(bool resim) { m_resimulating = resim; }
 
 	// misc
 	void toggle_record_movie(movie_recording::format format);
@@ -78,7 +81,8 @@ public:
 	bool snap_native() const { return m_snap_native; }
 	render_target &snapshot_target() { return *m_snap_target; }
 	void save_snapshot(screen_device *screen, emu_file &file);
-	void save_active_screen_snapshots();
+	void queue_snapshot(screen_device *screen, std::unique_ptr<emu_file> &&file);
+	void save_active_screen_snapshots(bool background = false);
 	void save_input_timecode();
 
 	// movies
@@ -98,6 +102,8 @@ public:
 	std::string &timecode_total_text(std::string &str);
 
 private:
+	class snapshot_encoder;
+
 	// internal helpers
 	void exit();
 	void screenless_update_callback(void *ptr, int param);
@@ -119,6 +125,7 @@ private:
 	// snapshot/movie helpers
 	void create_snapshot_bitmap(screen_device *screen);
 	void record_frame();
+	void save_sequence_snapshots();
 
 	// movies
 	void begin_recording_screen(const std::string &filename, uint32_t index, screen_device *screen, movie_recording::format format);
@@ -164,6 +171,7 @@ private:
 	u8                  m_frameskip_counter;        // counter that counts through the frameskip steps
 	s8                  m_frameskip_adjust;
 	bool                m_skipping_this_frame;      // flag: true if we are skipping the current frame
+	bool                m_resimulating;             // flag: true if netplay is silently replaying frames
 	osd_ticks_t         m_average_oversleep;        // average number of ticks the OSD oversleeps
 
 	// snapshot stuff
@@ -172,6 +180,9 @@ private:
 	bool                m_snap_native;              // are we using native per-screen layouts?
 	s32                 m_snap_width;               // width of snapshots (0 == auto)
 	s32                 m_snap_height;              // height of snapshots (0 == auto)
+	u32                 m_snap_sequence;            // save every Nth frame as a PNG (0 == off)
+	u32                 m_snap_sequence_frame;      // number of frames seen by the PNG sequence
+	std::unique_ptr<snapshot_encoder> m_snap_encoder; // background PNG writers
 
 	// movie recordings
 	std::vector<movie_recording::ptr> m_movie_recordings;
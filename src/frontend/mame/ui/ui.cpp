@@ -1358,7 +1358,7 @@ uint32_t mame_ui_manager::handler_ingame(render_container &container)
 
 	// handle a save snapshot request
 	if (machine().ui_input().pressed(IPT_UI_SNAPSHOT))
-		machine().video().save_active_screen_snapshots();
+		machine().video().save_active_screen_snapshots(true);
 
 	// toggle pause
 	if (machine().ui_input().pressed(IPT_UI_PAUSE))
@@ -1,6 +1,9 @@
 // license:BSD-3-Clause
 // copyright-holders:S. Smith,David Haywood
 #include "neogeo.h"
+#include "parallel.h"
+
+#include <algorithm>
 
 
 DEFINE_DEVICE_TYPE(NGBOOTLEG_PROT, ngbootleg_prot_device, "ngbootleg_prot", "NeoGeo Protection (Bootleg)")
@@ -25,45 +28,73 @@ void ngbootleg_prot_device::device_start()
 void ngbootleg_prot_device::device_reset() { }
 
 
-/* General Bootleg Functions - used by more than 1 game */
+/* Descrambling steps shared by the bootleg routines
 
+   Most bootleg ROM scrambles are built from two kinds of step: moving
+   fixed-size blocks around inside aligned groups of blocks, and
+   bit-swapping bytes. Both are run here a slice at a time on the work
+   queue. A block step only keeps a copy of the group it is working on,
+   rather than a copy of the whole ROM. */
 
-void ngbootleg_prot_device::neogeo_bootleg_cx_decrypt(u8*sprrom, u32 sprrom_size)
+namespace {
+
+// block i of rom takes the old contents of block map(i), which must lie in the same group of `group` blocks
+template <typename Map>
+void ngbootleg_permute_blocks(u8 *rom, u32 size, u32 block, u32 group, Map &&map)
 {
-	int i;
-	int cx_size = sprrom_size;
-	u8 *rom = sprrom;
-	std::vector<u8> buf( cx_size );
+	const u32 group_bytes = block * group;
+	parallel_for(size / group_bytes, std::max<u32>(1, 0x100000 / group_bytes),
+			[rom, block, group, group_bytes, &map] (u32 start, u32 end)
+			{
+				std::vector<u8> buf(group_bytes);
+				for (u32 g = start; g < end; g++)
+				{
+					u8 *const base = rom + g * group_bytes;
+					memcpy(&buf[0], base, group_bytes);
+					for (u32 i = 0; i < group; i++)
+					{
+						const u32 src = map(g * group + i) - g * group;
+						assert(src < group);
+						memcpy(base + i * block, &buf[src * block], block);
+					}
+				}
+			});
+}
 
-	memcpy( &buf[0], rom, cx_size );
+// replace every step'th byte in [start, end) with swap(byte)
+template <typename Swap>
+void ngbootleg_swap_bytes(u8 *rom, u32 start, u32 end, u32 step, Swap &&swap)
+{
+	u8 table[0x100];
+	for (int i = 0; i < 0x100; i++)
+		table[i] = swap(u8(i));
 
-	for( i = 0; i < cx_size / 0x40; i++ )
-		memcpy( &rom[ i * 0x40 ], &buf[ (i ^ 1) * 0x40 ], 0x40 );
+	parallel_for((end - start + step - 1) / step, 0x100000,
+			[rom, start, step, &table] (u32 first, u32 last)
+			{
+				for (u32 i = first; i < last; i++)
+					rom[start + i * step] = table[rom[start + i * step]];
+			});
 }
 
+} // anonymous namespace
 
-void ngbootleg_prot_device::neogeo_bootleg_sx_decrypt(u8* fixed, u32 fixed_size, int value )
+
+/* General Bootleg Functions - used by more than 1 game */
+
+
+void ngbootleg_prot_device::neogeo_bootleg_cx_decrypt(u8*sprrom, u32 sprrom_size)
 {
-	int sx_size = fixed_size;
-	u8 *rom = fixed;
-	int i;
+	ngbootleg_permute_blocks(sprrom, sprrom_size, 0x40, 2, [] (u32 i) { return i ^ 1; });
+}
 
-	if (value == 1)
-	{
-		std::vector<u8> buf( sx_size );
-		memcpy( &buf[0], rom, sx_size );
 
-		for( i = 0; i < sx_size; i += 0x10 )
-		{
-			memcpy( &rom[ i ], &buf[ i + 8 ], 8 );
-			memcpy( &rom[ i + 8 ], &buf[ i ], 8 );
-		}
-	}
+void ngbootleg_prot_device::neogeo_bootleg_sx_decrypt(u8* fixed, u32 fixed_size, int value )
+{
+	if (value == 1)
+		ngbootleg_permute_blocks(fixed, fixed_size, 8, 2, [] (u32 i) { return i ^ 1; });
 	else if (value == 2)
-	{
-		for( i = 0; i < sx_size; i++ )
-			rom[ i ] = bitswap<8>( rom[ i ], 7, 6, 0, 4, 3, 2, 1, 5 );
-	}
+		ngbootleg_swap_bytes(fixed, 0, fixed_size, 1, [] (u8 b) { return bitswap<8>( b, 7, 6, 0, 4, 3, 2, 1, 5 ); });
 }
 
 
@@ -216,39 +247,23 @@ void ngbootleg_prot_device::kf10thep_px_decrypt(u8* cpurom, u32 cpurom_size)
 
 void ngbootleg_prot_device::kf2k5uni_px_decrypt(u8* cpurom, u32 cpurom_size)
 {
-	int i, j, ofst;
 	u8 *src = cpurom;
-	u8 dst[0x80];
 
-	for (i = 0; i < 0x800000; i+=0x80)
-	{
-		for (j = 0; j < 0x80; j+=2)
-		{
-			ofst = bitswap<8>(j, 0, 3, 4, 5, 6, 1, 2, 7);
-			memcpy(&dst[j], src + i + ofst, 2);
-		}
-		memcpy(src + i, &dst[0], 0x80);
-	}
+	// words within each 0x80 byte block
+	ngbootleg_permute_blocks(src, 0x800000, 2, 0x40,
+			[] (u32 i) { return (i & ~0x3f) | (bitswap<8>((i & 0x3f) << 1, 0, 3, 4, 5, 6, 1, 2, 7) >> 1); });
 
 	memcpy(src, src + 0x600000, 0x100000); // Seems to be the same as kof10th
 }
 
 void ngbootleg_prot_device::kf2k5uni_sx_decrypt(u8* fixedrom, u32 fixedrom_size)
 {
-	int i;
-	u8 *srom = fixedrom;
-
-	for (i = 0; i < 0x20000; i++)
-		srom[i] = bitswap<8>(srom[i], 4, 5, 6, 7, 0, 1, 2, 3);
+	ngbootleg_swap_bytes(fixedrom, 0, 0x20000, 1, [] (u8 b) { return bitswap<8>(b, 4, 5, 6, 7, 0, 1, 2, 3); });
 }
 
 void ngbootleg_prot_device::kf2k5uni_mx_decrypt(u8* audiorom, u32 audiorom_size)
 {
-	int i;
-	u8 *mrom = audiorom;
-
-	for (i = 0; i < 0x30000; i++)
-		mrom[i] = bitswap<8>(mrom[i], 4, 5, 6, 7, 0, 1, 2, 3);
+	ngbootleg_swap_bytes(audiorom, 0, 0x30000, 1, [] (u8 b) { return bitswap<8>(b, 4, 5, 6, 7, 0, 1, 2, 3); });
 }
 
 void ngbootleg_prot_device::decrypt_kf2k5uni(u8* cpurom, u32 cpurom_size, u8* audiorom, u32 audiorom_size, u8* fixedrom, u32 fixedrom_size)
@@ -264,7 +279,6 @@ void ngbootleg_prot_device::decrypt_kf2k5uni(u8* cpurom, u32 cpurom_size, u8* au
 
 void ngbootleg_prot_device::kof2002b_gfx_decrypt(u8 *src, int size)
 {
-	int i, j;
 	static const u8 t[ 8 ][ 6 ] =
 	{
 		{ 0, 8, 7, 6, 2, 1 },
@@ -277,19 +291,16 @@ void ngbootleg_prot_device::kof2002b_gfx_decrypt(u8 *src, int size)
 		{ 8, 0, 7, 6, 2, 1 },
 	};
 
-	std::vector<u8> dst( 0x10000 );
-
-	for ( i = 0; i < size; i+=0x10000 )
+	// tile j of each 64KB group is moved to tile ofst; invert that to find each tile's source
+	u16 source[ 0x200 ];
+	for ( int j = 0; j < 0x200; j++ )
 	{
-		memcpy( &dst[0], src+i, 0x10000 );
-
-		for ( j = 0; j < 0x200; j++ )
-		{
-			int n = (j & 0x38) >> 3;
-			int ofst = bitswap<16>(j, 15, 14, 13, 12, 11, 10, 9, t[n][0], t[n][1], t[n][2], 5, 4, 3, t[n][3], t[n][4], t[n][5]);
-			memcpy( src+i+ofst*128, &dst[j*128], 128 );
-		}
+		int n = (j & 0x38) >> 3;
+		int ofst = bitswap<16>(j, 15, 14, 13, 12, 11, 10, 9, t[n][0], t[n][1], t[n][2], 5, 4, 3, t[n][3], t[n][4], t[n][5]);
+		source[ ofst ] = j;
 	}
+
+	ngbootleg_permute_blocks(src, size, 128, 0x200, [&source] (u32 i) { return (i & ~0x1ff) | source[ i & 0x1ff ]; });
 }
 
 
@@ -298,22 +309,13 @@ void ngbootleg_prot_device::kof2002b_gfx_decrypt(u8 *src, int size)
 
 void ngbootleg_prot_device::kf2k2mp_decrypt(u8* cpurom, u32 cpurom_size)
 {
-	int i,j;
-
 	u8 *src = cpurom;
-	u8 dst[0x80];
 
 	memmove(src, src + 0x300000, 0x500000);
 
-	for (i = 0; i < 0x800000; i+=0x80)
-	{
-		for (j = 0; j < 0x80 / 2; j++)
-		{
-			int ofst = bitswap<8>( j, 6, 7, 2, 3, 4, 5, 0, 1 );
-			memcpy(dst + j * 2, src + i + ofst * 2, 2);
-		}
-		memcpy(src + i, dst, 0x80);
-	}
+	// words within each 0x80 byte block
+	ngbootleg_permute_blocks(src, 0x800000, 2, 0x40,
+			[] (u32 i) { return (i & ~0x3f) | bitswap<8>( i & 0x3f, 6, 7, 2, 3, 4, 5, 0, 1 ); });
 }
 
 
@@ -339,23 +341,10 @@ void ngbootleg_prot_device::kf2k2mp2_px_decrypt(u8* cpurom, u32 cpurom_size)
 /* descrambling information from razoola */
 void ngbootleg_prot_device::cthd2003_neogeo_gfx_address_fix_do(u8* sprrom, u32 sprrom_size, int start, int end, int bit3shift, int bit2shift, int bit1shift, int bit0shift)
 {
-	int i,j;
 	int tilesize=128;
 
-	std::vector<u8> rom(16*tilesize); // 16 tiles buffer
-	u8* realrom = sprrom + start*tilesize;
-
-	for (i = 0; i < (end-start)/16; i++)
-	{
-		for (j = 0; j < 16; j++)
-		{
-			int offset = (((j&1)>>0)<<bit0shift) +(((j&2)>>1)<<bit1shift) +(((j&4)>>2)<<bit2shift) +(((j&8)>>3)<<bit3shift);
-
-			memcpy(&rom[j*tilesize], realrom+offset*tilesize, tilesize);
-		}
-		memcpy(realrom,&rom[0],tilesize*16);
-		realrom += 16*tilesize;
-	}
+	ngbootleg_permute_blocks(sprrom + start*tilesize, (end-start)/16*16*tilesize, tilesize, 16,
+			[=] (u32 j) { return (j & ~15) | (((j&1)>>0)<<bit0shift) | (((j&2)>>1)<<bit1shift) | (((j&4)>>2)<<bit2shift) | (((j&8)>>3)<<bit3shift); });
 }
 
 void ngbootleg_prot_device::cthd2003_neogeo_gfx_address_fix(u8* sprrom, u32 sprrom_size, int start, int end)
@@ -371,25 +360,20 @@ void ngbootleg_prot_device::cthd2003_neogeo_gfx_address_fix(u8* sprrom, u32 sprr
 
 void ngbootleg_prot_device::cthd2003_c(u8* sprrom, u32 sprrom_size, int pow)
 {
-	int i;
-
-	for (i=0; i<=192; i+=8)
-		cthd2003_neogeo_gfx_address_fix(sprrom, sprrom_size, i*512,i*512+512);
-
-	for (i=200; i<=392; i+=8)
-		cthd2003_neogeo_gfx_address_fix(sprrom, sprrom_size, i*512,i*512+512);
-
-	for (i=400; i<=592; i+=8)
-		cthd2003_neogeo_gfx_address_fix(sprrom, sprrom_size, i*512,i*512+512);
-
-	for (i=600; i<=792; i+=8)
-		cthd2003_neogeo_gfx_address_fix(sprrom, sprrom_size, i*512,i*512+512);
-
-	for (i=800; i<=992; i+=8)
-		cthd2003_neogeo_gfx_address_fix(sprrom, sprrom_size, i*512,i*512+512);
+	/* This is cthd2003_neogeo_gfx_address_fix on every 8*512 tile range of the
+	   first 64MB, done as one pass. The shifts for each 512 tile slice are
+	   bit3shift..bit0shift as passed there; slices 3 and 4 are left alone. */
+	static const u8 shifts[8][4] =
+	{
+		{ 0,3,2,1 }, { 1,0,3,2 }, { 2,1,0,3 }, { 3,2,1,0 }, { 3,2,1,0 }, { 0,1,2,3 }, { 0,1,2,3 }, { 0,2,3,1 }
+	};
 
-	for (i=1000; i<=1016; i+=8)
-		cthd2003_neogeo_gfx_address_fix(sprrom, sprrom_size, i*512,i*512+512);
+	ngbootleg_permute_blocks(sprrom, std::min<u32>(sprrom_size, 1024*512*128), 128, 16,
+			[] (u32 j)
+			{
+				const u8 *shift = shifts[(j >> 9) & 7];
+				return (j & ~15) | (((j&1)>>0)<<shift[3]) | (((j&2)>>1)<<shift[2]) | (((j&4)>>2)<<shift[1]) | (((j&8)>>3)<<shift[0]);
+			});
 }
 
 void ngbootleg_prot_device::decrypt_cthd2003(u8* sprrom, u32 sprrom_size, u8* audiorom, u32 audiorom_size, u8* fixedrom, u32 fixedrom_size)
@@ -584,9 +568,7 @@ void ngbootleg_prot_device::decrypt_kof2k4se_68k(u8* cpurom, u32 cpurom_size)
 
 void ngbootleg_prot_device::lans2004_vx_decrypt(u8* ymsndrom, u32 ymsndrom_size)
 {
-	u8 *rom = ymsndrom;
-	for (u8 i = 0; i < 0xA00000; i++)
-		rom[i] = bitswap<8>(rom[i], 0, 1, 5, 4, 3, 2, 6, 7);
+	ngbootleg_swap_bytes(ymsndrom, 0, 0xA00000, 1, [] (u8 b) { return bitswap<8>(b, 0, 1, 5, 4, 3, 2, 6, 7); });
 }
 
 void ngbootleg_prot_device::lans2004_decrypt_68k(u8* cpurom, u32 cpurom_size)
@@ -670,26 +652,14 @@ void ngbootleg_prot_device::install_ms5plus_protection(cpu_device* maincpu, neog
 void ngbootleg_prot_device::mslug5b_vx_decrypt(u8* ymsndrom, u32 ymsndrom_size)
 {
 	// only odd bytes are scrambled
-	int ym_size = ymsndrom_size;
-	u8 *rom = ymsndrom;
-	for (int i = 1; i < ym_size; i += 2)
-		rom[i] = bitswap<8>(rom[i], 3, 2, 4, 1, 5, 0, 6, 7);
+	ngbootleg_swap_bytes(ymsndrom, 1, ymsndrom_size, 2, [] (u8 b) { return bitswap<8>(b, 3, 2, 4, 1, 5, 0, 6, 7); });
 }
 
 void ngbootleg_prot_device::mslug5b_cx_decrypt(u8* sprrom, u32 sprrom_size)
 {
 	// rom a18/a19 lines are swapped
-	int cx_size = sprrom_size;
-	u8 *rom = sprrom;
-	std::vector<u8> buf(cx_size);
-
-	memcpy(&buf[0], rom, cx_size);
-
-	for (int i = 1; i < 128; i += 4)
-	{
-		memcpy(&rom[i * 0x80000], &buf[(i + 1) * 0x80000], 0x80000);
-		memcpy(&rom[(i + 1) * 0x80000], &buf[i * 0x80000], 0x80000);
-	}
+	ngbootleg_permute_blocks(sprrom, std::min<u32>(sprrom_size, 128 * 0x80000), 0x80000, 4,
+			[] (u32 i) { return ((i & 3) == 1 || (i & 3) == 2) ? (i ^ 3) : i; });
 }
 
 
@@ -699,43 +669,30 @@ void ngbootleg_prot_device::mslug5b_cx_decrypt(u8* sprrom, u32 sprrom_size)
 void ngbootleg_prot_device::svcboot_px_decrypt(u8* cpurom, u32 cpurom_size)
 {
 	static const u8 sec[] = { 0x06, 0x07, 0x01, 0x02, 0x03, 0x04, 0x05, 0x00 };
-	int i;
 	int size = cpurom_size;
 	u8 *src = cpurom;
-	std::vector<u8> dst( size );
-	int ofst;
-	for( i = 0; i < size / 0x100000; i++ )
-		memcpy( &dst[ i * 0x100000 ], &src[ sec[ i ] * 0x100000 ], 0x100000 );
 
-	for( i = 0; i < size / 2; i++ )
-	{
-		ofst = bitswap<8>( (i & 0x0000ff), 7, 6, 1, 0, 3, 2, 5, 4 );
-		ofst += (i & 0xffff00);
-		memcpy( &src[ i * 2 ], &dst[ ofst * 2 ], 0x02 );
-	}
+	// 1MB banks, then words within each 0x200 bytes
+	ngbootleg_permute_blocks(src, size, 0x100000, size / 0x100000, [] (u32 i) { return sec[ i ]; });
+	ngbootleg_permute_blocks(src, size, 2, 0x100,
+			[] (u32 i) { return (i & 0xffff00) | bitswap<8>( (i & 0x0000ff), 7, 6, 1, 0, 3, 2, 5, 4 ); });
 }
 
 void ngbootleg_prot_device::svcboot_cx_decrypt(u8*sprrom, u32 sprrom_size)
 {
 	static const u8 idx_tbl[ 0x10 ] = { 0, 1, 0, 1, 2, 3, 2, 3, 3, 4, 3, 4, 4, 5, 4, 5 };
 	static const u8 bitswap4_tbl[ 6 ][ 4 ] = { { 3, 0, 1, 2 }, { 2, 3, 0, 1 }, { 1, 2, 3, 0 }, { 0, 1, 2, 3 }, { 3, 2, 1, 0 }, { 3, 0, 2, 1 } };
-	int i;
-	int size = sprrom_size;
-	u8 *src = sprrom;
-	std::vector<u8> dst( size );
-	int ofst;
-	memcpy( &dst[0], src, size );
-	for( i = 0; i < size / 0x80; i++ )
-	{
-		int idx = idx_tbl[ (i & 0xf00) >> 8 ];
-		int bit0 = bitswap4_tbl[ idx ][ 0 ];
-		int bit1 = bitswap4_tbl[ idx ][ 1 ];
-		int bit2 = bitswap4_tbl[ idx ][ 2 ];
-		int bit3 = bitswap4_tbl[ idx ][ 3 ];
-		ofst = bitswap<8>( (i & 0x0000ff), 7, 6, 5, 4, bit3, bit2, bit1, bit0 );
-		ofst += (i & 0xfffff00);
-		memcpy( &src[ i * 0x80 ], &dst[ ofst * 0x80 ], 0x80 );
-	}
+	// tiles within each group of 0x100, in an order set by the group number
+	ngbootleg_permute_blocks(sprrom, sprrom_size, 0x80, 0x100,
+			[] (u32 i)
+			{
+				int idx = idx_tbl[ (i & 0xf00) >> 8 ];
+				int bit0 = bitswap4_tbl[ idx ][ 0 ];
+				int bit1 = bitswap4_tbl[ idx ][ 1 ];
+				int bit2 = bitswap4_tbl[ idx ][ 2 ];
+				int bit3 = bitswap4_tbl[ idx ][ 3 ];
+				return (i & 0xfffff00) | bitswap<8>( (i & 0x0000ff), 7, 6, 5, 4, bit3, bit2, bit1, bit0 );
+			});
 }
 
 
@@ -977,11 +934,7 @@ void ngbootleg_prot_device::samsho5b_px_decrypt(u8* cpurom, u32 cpurom_size)
 
 void ngbootleg_prot_device::samsho5b_vx_decrypt(u8* ymsndrom, u32 ymsndrom_size)
 {
-	int vx_size = ymsndrom_size;
-	u8 *rom = ymsndrom;
-
-	for( int i = 0; i < vx_size; i++ )
-		rom[ i ] = bitswap<8>( rom[ i ], 0, 1, 5, 4, 3, 2, 6, 7 );
+	ngbootleg_swap_bytes(ymsndrom, 0, ymsndrom_size, 1, [] (u8 b) { return bitswap<8>( b, 0, 1, 5, 4, 3, 2, 6, 7 ); });
 }
 
 
@@ -1559,48 +1512,65 @@ void cmc_prot_device::decrypt(u8 *r0, u8 *r1, u8 c0,  u8 c1, const u8 *table0hi,
 
 void cmc_prot_device::neogeo_gfx_decrypt(u8* rom, u32 rom_size, int extra_xor)
 {
-	int rpos;
-	std::vector<u8> buf(rom_size);
-
-	// Data xor
-	for (rpos = 0;rpos < rom_size/4;rpos++)
+	/* The data xor of a word depends only on the low 16 bits of its address, so it
+	   is tabulated once rather than looked up through six tables per word. Each
+	   output word is then the address-scrambled source word decrypted with the
+	   source address, which turns the two passes over the ROM into one. */
+	std::vector<u8> xortable(4 * 0x10000);
+	for (int base = 0; base < 0x10000; base++)
 	{
-		decrypt(&buf[4*rpos+0], &buf[4*rpos+3], rom[4*rpos+0], rom[4*rpos+3], type0_t03, type0_t12, type1_t03, rpos, (rpos>>8) & 1);
-		decrypt(&buf[4*rpos+1], &buf[4*rpos+2], rom[4*rpos+1], rom[4*rpos+2], type0_t12, type0_t03, type1_t12, rpos, ((rpos>>16) ^ address_16_23_xor2[(rpos>>8) & 0xff]) & 1);
+		decrypt(&xortable[4*base+0], &xortable[4*base+3], 0, 0, type0_t03, type0_t12, type1_t03, base, 0);
+		decrypt(&xortable[4*base+1], &xortable[4*base+2], 0, 0, type0_t12, type0_t03, type1_t12, base, 0);
 	}
 
-	// Address xor
-	for (rpos = 0;rpos < rom_size/4;rpos++)
-	{
-		int baser = rpos ^ extra_xor;
-		baser ^= address_8_15_xor1[(baser >> 16) & 0xff] << 8;
-		baser ^= address_8_15_xor2[baser & 0xff] << 8;
-		baser ^= address_16_23_xor1[baser & 0xff] << 16;
-		baser ^= address_16_23_xor2[(baser >> 8) & 0xff] << 16;
-		baser ^= address_0_7_xor[(baser >> 8) & 0xff];
+	// the address scramble is a permutation of the whole ROM, so the source has to be kept
+	const std::vector<u8> buf(rom, rom + rom_size);
+	const int words = rom_size / 4;
 
-		if (rom_size == 0x3000000) /* special handling for preisle2 */
-		{
-			if (rpos < 0x2000000/4)
-				baser &= (0x2000000/4)-1;
-			else
-				baser = 0x2000000/4 + (baser & ((0x1000000/4)-1));
-		}
-		else if (rom_size == 0x6000000) /* special handling for kf2k3pcb */
+	auto const decrypt_range = [&] (int start, int end)
+	{
+		for (int rpos = start; rpos < end; rpos++)
 		{
-			if (rpos < 0x4000000/4)
-				baser &= (0x4000000/4)-1;
-			else
-				baser = 0x4000000/4 + (baser & ((0x1000000/4)-1));
+			// Address xor
+			int baser = rpos ^ extra_xor;
+			baser ^= address_8_15_xor1[(baser >> 16) & 0xff] << 8;
+			baser ^= address_8_15_xor2[baser & 0xff] << 8;
+			baser ^= address_16_23_xor1[baser & 0xff] << 16;
+			baser ^= address_16_23_xor2[(baser >> 8) & 0xff] << 16;
+			baser ^= address_0_7_xor[(baser >> 8) & 0xff];
+
+			if (rom_size == 0x3000000) /* special handling for preisle2 */
+			{
+				if (rpos < 0x2000000/4)
+					baser &= (0x2000000/4)-1;
+				else
+					baser = 0x2000000/4 + (baser & ((0x1000000/4)-1));
+			}
+			else if (rom_size == 0x6000000) /* special handling for kf2k3pcb */
+			{
+				if (rpos < 0x4000000/4)
+					baser &= (0x4000000/4)-1;
+				else
+					baser = 0x4000000/4 + (baser & ((0x1000000/4)-1));
+			}
+			else /* Clamp to the real rom size */
+				baser &= (rom_size/4)-1;
+
+			// Data xor, as decrypt() does at the source address
+			const u8 *src = &buf[4*baser];
+			const u8 *x = &xortable[4*(baser & 0xffff)];
+			const bool invert0 = (baser >> 8) & 1;
+			const bool invert1 = ((baser >> 16) ^ address_16_23_xor2[(baser >> 8) & 0xff]) & 1;
+
+			rom[4*rpos+0] = src[invert0 ? 3 : 0] ^ x[0];
+			rom[4*rpos+3] = src[invert0 ? 0 : 3] ^ x[3];
+			rom[4*rpos+1] = src[invert1 ? 2 : 1] ^ x[1];
+			rom[4*rpos+2] = src[invert1 ? 1 : 2] ^ x[2];
 		}
-		else /* Clamp to the real rom size */
-			baser &= (rom_size/4)-1;
+	};
 
-		rom[4*rpos+0] = buf[4*baser+0];
-		rom[4*rpos+1] = buf[4*baser+1];
-		rom[4*rpos+2] = buf[4*baser+2];
-		rom[4*rpos+3] = buf[4*baser+3];
-	}
+	// every output word is written by exactly one slice
+	parallel_for(words, 0x10000, decrypt_range);
 }
 
 
@@ -2268,16 +2238,53 @@ DEFINE_DEVICE_TYPE(PVC_PROT, pvc_prot_device, "pvc_prot", "NeoGeo Protection (PV
 pvc_prot_device::pvc_prot_device(const machine_config &mconfig, const char *tag, device_t *owner, u32 clock)
 	: device_t(mconfig, PVC_PROT, tag, owner, clock)
 	, m_bankdev(nullptr)
+	, m_unpack_pending(false)
+	, m_pack_pending(false)
+	, m_screen(nullptr)
+	, m_stats_frame(0)
+	, m_stats_reads(0)
+	, m_stats_writes(0)
+	, m_stats_conversions(0)
 	{ }
 
 
 void pvc_prot_device::device_start()
 {
+	// each colour conversion only moves bits around, so it splits into a lookup per source byte
+	for (int i = 0; i < 0x100; i++)
+	{
+		const u16 lo = i, hi = i << 8;
+
+		// pen -> GB (0xff1) in the low half, SR (0xff2) in the high half
+		m_unpack_lo[i] = ((((lo & 0x00f0) >> 3) << 8) | ((lo & 0x000f) << 1));
+		m_unpack_hi[i] = ((((hi & 0x2000) >> 13) << 8) | ((hi & 0x1000) >> 12)) |
+				(u32((((hi & 0x8000) >> 15) << 8) | ((hi & 0x0f00) >> 7) | ((hi & 0x4000) >> 14)) << 16);
+
+		m_pack_gb[0][i] = ((lo & 0x001e) >> 1) | ((lo & 0x0001) << 12);
+		m_pack_gb[1][i] = ((hi & 0x1e00) >> 5) | ((hi & 0x0100) << 5);
+		m_pack_sr[0][i] = ((lo & 0x001e) << 7) | ((lo & 0x0001) << 14);
+		m_pack_sr[1][i] = ((hi & 0x0100) << 7);
+	}
+
+	m_screen = screen_device_enumerator(machine().root_device()).first();
+
 	save_item(NAME(m_cartridge_ram));
 }
 
 void pvc_prot_device::device_reset() { }
 
+void pvc_prot_device::device_pre_save()
+{
+	pvc_flush_colors();
+}
+
+void pvc_prot_device::device_post_load()
+{
+	// the saved RAM already holds every result
+	m_unpack_pending = false;
+	m_pack_pending = false;
+}
+
 
 
 
@@ -2288,14 +2295,12 @@ void pvc_prot_device::device_reset() { }
 void pvc_prot_device::pvc_write_unpack_color()
 {
 	u16 pen = m_cartridge_ram[0xff0];
+	u32 gbsr = m_unpack_lo[pen & 0xff] | m_unpack_hi[pen >> 8];
 
-	u8 b = ((pen & 0x000f) << 1) | ((pen & 0x1000) >> 12);
-	u8 g = ((pen & 0x00f0) >> 3) | ((pen & 0x2000) >> 13);
-	u8 r = ((pen & 0x0f00) >> 7) | ((pen & 0x4000) >> 14);
-	u8 s = (pen & 0x8000) >> 15;
-
-	m_cartridge_ram[0xff1] = (g << 8) | b;
-	m_cartridge_ram[0xff2] = (s << 8) | r;
+	m_cartridge_ram[0xff1] = gbsr & 0xffff;
+	m_cartridge_ram[0xff2] = gbsr >> 16;
+	m_unpack_pending = false;
+	m_stats_conversions++;
 }
 
 
@@ -2304,8 +2309,37 @@ void pvc_prot_device::pvc_write_pack_color()
 	u16 gb = m_cartridge_ram[0xff4];
 	u16 sr = m_cartridge_ram[0xff5];
 
-	m_cartridge_ram[0xff6] = ((gb & 0x001e) >> 1) | ((gb & 0x1e00) >> 5) | ((sr & 0x001e) << 7) |
-		((gb & 0x0001) << 12) | ((gb & 0x0100) << 5) | ((sr & 0x0001) << 14) | ((sr & 0x0100) << 7);
+	m_cartridge_ram[0xff6] = m_pack_gb[0][gb & 0xff] | m_pack_gb[1][gb >> 8] | m_pack_sr[0][sr & 0xff] | m_pack_sr[1][sr >> 8];
+	m_pack_pending = false;
+	m_stats_conversions++;
+}
+
+
+/* The game usually writes both halves of a colour (or a byte at a time)
+   before reading the result, so the conversion is only done once the
+   result is actually needed. */
+void pvc_prot_device::pvc_flush_colors()
+{
+	if (m_unpack_pending)
+		pvc_write_unpack_color();
+	if (m_pack_pending)
+		pvc_write_pack_color();
+}
+
+
+void pvc_prot_device::pvc_count_access(u32 &counter)
+{
+	counter++;
+	if (m_screen && (m_screen->frame_number() != m_stats_frame))
+	{
+		const u64 frame = m_screen->frame_number();
+		if ((frame / 600) != (m_stats_frame / 600))
+		{
+			logerror("PVC: %u reads, %u writes, %u colour conversions in the last 600 frames\n", m_stats_reads, m_stats_writes, m_stats_conversions);
+			m_stats_reads = m_stats_writes = m_stats_conversions = 0;
+		}
+		m_stats_frame = frame;
+	}
 }
 
 
@@ -2320,18 +2354,29 @@ void pvc_prot_device::pvc_write_bankswitch()
 
 u16 pvc_prot_device::pvc_prot_r(offs_t offset)
 {
+	if (!machine().side_effects_disabled())
+		pvc_count_access(m_stats_reads);
+
+	if ((m_unpack_pending && (offset == 0xff1 || offset == 0xff2)) || (m_pack_pending && offset == 0xff6))
+		pvc_flush_colors();
 	return m_cartridge_ram[offset];
 }
 
 
 void pvc_prot_device::pvc_prot_w(offs_t offset, u16 data, u16 mem_mask)
 {
+	pvc_count_access(m_stats_writes);
+
+	// don't let a pending conversion overwrite this write later
+	if ((m_unpack_pending && (offset == 0xff1 || offset == 0xff2)) || (m_pack_pending && offset == 0xff6))
+		pvc_flush_colors();
+
 	COMBINE_DATA(&m_cartridge_ram[offset] );
 	if (offset == 0xff0)
-		pvc_write_unpack_color();
+		m_unpack_pending = true;
 	else
 	if(offset >= 0xff4 && offset <= 0xff5)
-		pvc_write_pack_color();
+		m_pack_pending = true;
 	else
 	if(offset >= 0xff8)
 		pvc_write_bankswitch();
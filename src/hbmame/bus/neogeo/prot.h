@@ -315,6 +315,25 @@ public:
 protected:
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_pre_save() override;
+	virtual void device_post_load() override;
+
+private:
+	void pvc_flush_colors();
+	void pvc_count_access(u32 &counter);
+
+	// colour conversions, indexed by the low and high byte of the source words
+	u32 m_unpack_lo[0x100], m_unpack_hi[0x100];     // 0xff0 -> 0xff1 (low half), 0xff2 (high half)
+	u16 m_pack_gb[2][0x100], m_pack_sr[2][0x100];   // 0xff4, 0xff5 -> 0xff6
+
+	// conversions are done when their result is next read or overwritten
+	bool m_unpack_pending;
+	bool m_pack_pending;
+
+	// access statistics for the current logging period
+	screen_device *m_screen;
+	u64 m_stats_frame;
+	u32 m_stats_reads, m_stats_writes, m_stats_conversions;
 };
 
 
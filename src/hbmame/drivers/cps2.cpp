@@ -174,6 +174,13 @@ the decryption keys.
 #include "speaker.h"
 #include "ui/uimain.h"
 
+#include "emuopts.h"
+#include "hashing.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <vector>
+
 static const int fn1_groupA[8] = { 10, 4, 6, 7, 2, 13, 15, 14 };
 static const int fn1_groupB[8] = {  0, 1, 3, 5, 8,  9, 11, 12 };
 
@@ -685,94 +692,169 @@ static void optimise_sboxes(struct optimised_sbox* out, const struct sbox* in)
 
 
 
-static void cps2_decrypt(running_machine &machine, u16 *rom, u16 *dec, int length, const u32 *master_key, u32 lower_limit, u32 upper_limit)
+// everything the per-address work needs, set up once per decryption
+struct cps2_decrypt_context
 {
-	int i;
+	const u16 *rom;
+	u16 *dec;
+	int length;
+	const u32 *master_key;
+	u32 lower_limit;
+	u32 upper_limit;
 	u32 key1[4];
 	struct optimised_sbox sboxes1[4*4];
 	struct optimised_sbox sboxes2[4*4];
+};
 
-	optimise_sboxes(&sboxes1[0*4], fn1_r1_boxes);
-	optimise_sboxes(&sboxes1[1*4], fn1_r2_boxes);
-	optimise_sboxes(&sboxes1[2*4], fn1_r3_boxes);
-	optimise_sboxes(&sboxes1[3*4], fn1_r4_boxes);
-	optimise_sboxes(&sboxes2[0*4], fn2_r1_boxes);
-	optimise_sboxes(&sboxes2[1*4], fn2_r2_boxes);
-	optimise_sboxes(&sboxes2[2*4], fn2_r3_boxes);
-	optimise_sboxes(&sboxes2[3*4], fn2_r4_boxes);
+// number of key positions handled together by each stage of a batch
+#define CPS2_DECRYPT_BATCH  64
 
 
-	// expand master key to 1st FN 96-bit key
-	expand_1st_key(key1, master_key);
+static void cps2_decrypt_range(const cps2_decrypt_context &ctx, int first, int last)
+{
+	u32 key2[CPS2_DECRYPT_BATCH][4];
 
-	// add extra bits for s-boxes with less than 6 inputs
-	key1[0] ^= BIT(key1[0], 1) <<  4;
-	key1[0] ^= BIT(key1[0], 2) <<  5;
-	key1[0] ^= BIT(key1[0], 8) << 11;
-	key1[1] ^= BIT(key1[1], 0) <<  5;
-	key1[1] ^= BIT(key1[1], 8) << 11;
-	key1[2] ^= BIT(key1[2], 1) <<  5;
-	key1[2] ^= BIT(key1[2], 8) << 11;
-
-	for (i = 0; i < 0x10000; ++i)
+	for (int base = first; base < last; base += CPS2_DECRYPT_BATCH)
 	{
-		int a;
-		u16 seed;
-		u32 subkey[2];
-		u32 key2[4];
+		const int count = std::min(CPS2_DECRYPT_BATCH, last - base);
 
-		if ((i & 0xff) == 0)
+		// derive the 2nd FN key of every position in the batch first, so the
+		// FN1 s-box tables stay hot, then run the opcodes through FN2
+		for (int j = 0; j < count; ++j)
 		{
-			/*char loadingMessage[256]; // for displaying with UI
-			sprintf(loadingMessage, "Decrypting %d%%", i*100/0x10000);
-			machine.ui().set_startup_text(loadingMessage,false);*/
+			u16 seed;
+			u32 subkey[2];
+
+			// pass the address through FN1
+			seed = feistel(base + j, fn1_groupA, fn1_groupB,
+					&ctx.sboxes1[0*4], &ctx.sboxes1[1*4], &ctx.sboxes1[2*4], &ctx.sboxes1[3*4],
+					ctx.key1[0], ctx.key1[1], ctx.key1[2], ctx.key1[3]);
+
+			// expand the result to 64-bit
+			expand_subkey(subkey, seed);
+
+			// XOR with the master key
+			subkey[0] ^= ctx.master_key[0];
+			subkey[1] ^= ctx.master_key[1];
+
+			// expand key to 2nd FN 96-bit key
+			u32 *const key = key2[j];
+			expand_2nd_key(key, subkey);
+
+			// add extra bits for s-boxes with less than 6 inputs
+			key[0] ^= BIT(key[0], 0) <<  5;
+			key[0] ^= BIT(key[0], 6) << 11;
+			key[1] ^= BIT(key[1], 0) <<  5;
+			key[1] ^= BIT(key[1], 1) <<  4;
+			key[2] ^= BIT(key[2], 2) <<  5;
+			key[2] ^= BIT(key[2], 3) <<  4;
+			key[2] ^= BIT(key[2], 7) << 11;
+			key[3] ^= BIT(key[3], 1) <<  5;
 		}
 
-
-		// pass the address through FN1
-		seed = feistel(i, fn1_groupA, fn1_groupB,
-				&sboxes1[0*4], &sboxes1[1*4], &sboxes1[2*4], &sboxes1[3*4],
-				key1[0], key1[1], key1[2], key1[3]);
+		// decrypt the opcodes
+		for (int j = 0; j < count; ++j)
+		{
+			const u32 *const key = key2[j];
+			for (int a = base + j; a < ctx.length/2; a += 0x10000)
+			{
+				if (a >= ctx.lower_limit && a <= ctx.upper_limit)
+				{
+					ctx.dec[a] = feistel(ctx.rom[a], fn2_groupA, fn2_groupB,
+						&ctx.sboxes2[0 * 4], &ctx.sboxes2[1 * 4], &ctx.sboxes2[2 * 4], &ctx.sboxes2[3 * 4],
+						key[0], key[1], key[2], key[3]);
+				}
+				else
+				{
+					ctx.dec[a] = ctx.rom[a];
+				}
+			}
+		}
+	}
+}
 
 
-		// expand the result to 64-bit
-		expand_subkey(subkey, seed);
+static void cps2_decrypt(running_machine &machine, u16 *rom, u16 *dec, int length, const u32 *master_key, u32 lower_limit, u32 upper_limit)
+{
+	cps2_decrypt_context ctx;
+	ctx.rom = rom;
+	ctx.dec = dec;
+	ctx.length = length;
+	ctx.master_key = master_key;
+	ctx.lower_limit = lower_limit;
+	ctx.upper_limit = upper_limit;
+
+	optimise_sboxes(&ctx.sboxes1[0*4], fn1_r1_boxes);
+	optimise_sboxes(&ctx.sboxes1[1*4], fn1_r2_boxes);
+	optimise_sboxes(&ctx.sboxes1[2*4], fn1_r3_boxes);
+	optimise_sboxes(&ctx.sboxes1[3*4], fn1_r4_boxes);
+	optimise_sboxes(&ctx.sboxes2[0*4], fn2_r1_boxes);
+	optimise_sboxes(&ctx.sboxes2[1*4], fn2_r2_boxes);
+	optimise_sboxes(&ctx.sboxes2[2*4], fn2_r3_boxes);
+	optimise_sboxes(&ctx.sboxes2[3*4], fn2_r4_boxes);
 
-		// XOR with the master key
-		subkey[0] ^= master_key[0];
-		subkey[1] ^= master_key[1];
 
-		// expand key to 2nd FN 96-bit key
-		expand_2nd_key(key2, subkey);
+	// expand master key to 1st FN 96-bit key
+	expand_1st_key(ctx.key1, master_key);
 
-		// add extra bits for s-boxes with less than 6 inputs
-		key2[0] ^= BIT(key2[0], 0) <<  5;
-		key2[0] ^= BIT(key2[0], 6) << 11;
-		key2[1] ^= BIT(key2[1], 0) <<  5;
-		key2[1] ^= BIT(key2[1], 1) <<  4;
-		key2[2] ^= BIT(key2[2], 2) <<  5;
-		key2[2] ^= BIT(key2[2], 3) <<  4;
-		key2[2] ^= BIT(key2[2], 7) << 11;
-		key2[3] ^= BIT(key2[3], 1) <<  5;
+	// add extra bits for s-boxes with less than 6 inputs
+	ctx.key1[0] ^= BIT(ctx.key1[0], 1) <<  4;
+	ctx.key1[0] ^= BIT(ctx.key1[0], 2) <<  5;
+	ctx.key1[0] ^= BIT(ctx.key1[0], 8) << 11;
+	ctx.key1[1] ^= BIT(ctx.key1[1], 0) <<  5;
+	ctx.key1[1] ^= BIT(ctx.key1[1], 8) << 11;
+	ctx.key1[2] ^= BIT(ctx.key1[2], 1) <<  5;
+	ctx.key1[2] ^= BIT(ctx.key1[2], 8) << 11;
+
+	// every one of the 0x10000 key positions is independent, and each one
+	// only writes the words whose address matches it, so split them up
+	parallel_for(0x10000, 0x1000, [&ctx] (u32 start, u32 end) { cps2_decrypt_range(ctx, start, end); });
+}
 
 
-		// decrypt the opcodes
-		for (a = i; a < length/2; a += 0x10000)
-		{
-			if (a >= lower_limit && a <= upper_limit)
-			{
-				dec[a] = feistel(rom[a], fn2_groupA, fn2_groupB,
-					&sboxes2[0 * 4], &sboxes2[1 * 4], &sboxes2[2 * 4], &sboxes2[3 * 4],
-					key2[0], key2[1], key2[2], key2[3]);
-			}
-			else
-			{
-				dec[a] = rom[a];
-			}
-		}
+/* The decrypted opcodes can be kept in the crypt cache directory, keyed on
+   the CRC of the encrypted program and on the key, and reused next time.
+   Words are stored and checksummed little-endian so the file can be shared
+   between hosts. */
+static void cps2_decrypt_cache_pack(std::vector<u8> &buffer, const u16 *words, int length)
+{
+	buffer.resize(length);
+	for (int a = 0; a < length / 2; a++)
+	{
+		buffer[a * 2] = words[a] & 0xff;
+		buffer[a * 2 + 1] = words[a] >> 8;
 	}
 }
 
+static std::string cps2_decrypt_cache_name(const u16 *rom, int length, const u32 *key, u32 lower, u32 upper)
+{
+	std::vector<u8> buffer;
+	cps2_decrypt_cache_pack(buffer, rom, length);
+	const u32 romcrc = util::crc32_creator::simple(&buffer[0], length);
+	return string_format("cps2_%08x_%08x%08x_%06x_%06x.dec", romcrc, key[0], key[1], lower, upper);
+}
+
+static bool cps2_decrypt_cache_load(emu_file &file, u16 *dec, int length)
+{
+	if (file.size() != u64(length))
+		return false;
+
+	std::vector<u8> buffer(length);
+	if (file.read(&buffer[0], length) != u32(length))
+		return false;
+
+	for (int a = 0; a < length / 2; a++)
+		dec[a] = buffer[a * 2] | (buffer[a * 2 + 1] << 8);
+	return true;
+}
+
+static void cps2_decrypt_cache_save(emu_file &file, const u16 *dec, int length)
+{
+	std::vector<u8> buffer;
+	cps2_decrypt_cache_pack(buffer, dec, length);
+	file.write(&buffer[0], length);
+}
+
 struct game_keys
 {
 	const char *name;             /* game driver name */
@@ -825,8 +907,32 @@ void cps2_state::init_cps2crypt()
 
 		logerror("cps2 decrypt 0x%08x,0x%08x,0x%08x,0x%08x\n", key[0], key[1], lower, upper);
 
+		u16 *const rom = (u16 *)memregion("maincpu")->base();
+		const int length = memregion("maincpu")->bytes() & ~1;
+
+		// reuse an earlier result if the crypt cache has one
+		const char *const cachedir = machine().options().cryptcache_directory();
+		std::string cachename;
+		if (cachedir && *cachedir)
+		{
+			cachename = cps2_decrypt_cache_name(rom, length, key, lower, upper);
+			emu_file cachefile(cachedir, OPEN_FLAG_READ);
+			if (cachefile.open(cachename) == osd_file::error::NONE && cps2_decrypt_cache_load(cachefile, m_decrypted_opcodes, length))
+			{
+				logerror("cps2 decrypt loaded from cache %s\n", cachename);
+				return;
+			}
+		}
+
 		// we have a proper key so use it to decrypt
-		cps2_decrypt(machine(), (u16 *)memregion("maincpu")->base(), m_decrypted_opcodes, memregion("maincpu")->bytes(), key, lower / 2, upper / 2);
+		cps2_decrypt(machine(), rom, m_decrypted_opcodes, length, key, lower / 2, upper / 2);
+
+		if (!cachename.empty())
+		{
+			emu_file cachefile(cachedir, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+			if (cachefile.open(cachename) == osd_file::error::NONE)
+				cps2_decrypt_cache_save(cachefile, m_decrypted_opcodes, length);
+		}
 	}
 }
 
@@ -1617,21 +1617,18 @@ INPUT_PORTS_END
 void fcrash_state::fcrash_update_transmasks()
 {
 	int i;
+	int masks[4];
 
 	for (i = 0; i < 4; i++)
 	{
-		int mask;
-
 		/* Get transparency registers */
 		if (m_layer_mask_reg[i])
-			mask = m_cps_b_regs[m_layer_mask_reg[i] / 2] ^ 0xffff;
+			masks[i] = m_cps_b_regs[m_layer_mask_reg[i] / 2] ^ 0xffff;
 		else
-			mask = 0xffff;  /* completely transparent if priority masks not defined (mercs, qad) */
-
-		m_bg_tilemap[0]->set_transmask(i, mask, 0x8000);
-		m_bg_tilemap[1]->set_transmask(i, mask, 0x8000);
-		m_bg_tilemap[2]->set_transmask(i, mask, 0x8000);
+			masks[i] = 0xffff;  /* completely transparent if priority masks not defined (mercs, qad) */
 	}
+
+	cps1_set_transmasks(masks);
 }
 
 void fcrash_state::bootleg_render_sprites( screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect )
@@ -1704,54 +1701,48 @@ void fcrash_state::fcrash_render_high_layer( screen_device &screen, bitmap_ind16
 	}
 }
 
-void fcrash_state::fcrash_build_palette()
+rgb_t fcrash_state::fcrash_palette_colour(u16 palette)
 {
-	int offset;
-
-	// all the bootlegs seem to write the palette offset as usual
-	int palettebase = (m_cps_a_regs[0x0a / 2] << 8) & 0x1ffff;
+	int r, g, b, bright;
 
-	for (offset = 0; offset < 32 * 6 * 16; offset++)
-	{
-		int palette = m_gfxram[palettebase / 2 + offset];
-		int r, g, b, bright;
+	// from my understanding of the schematics, when the 'brightness'
+	// component is set to 0 it should reduce brightness to 1/3
 
-		// from my understanding of the schematics, when the 'brightness'
-		// component is set to 0 it should reduce brightness to 1/3
+	bright = 0x0f + ((palette >> 12) << 1);
 
-		bright = 0x0f + ((palette >> 12) << 1);
+	r = ((palette >> 8) & 0x0f) * 0x11 * bright / 0x2d;
+	g = ((palette >> 4) & 0x0f) * 0x11 * bright / 0x2d;
+	b = ((palette >> 0) & 0x0f) * 0x11 * bright / 0x2d;
 
-		r = ((palette >> 8) & 0x0f) * 0x11 * bright / 0x2d;
-		g = ((palette >> 4) & 0x0f) * 0x11 * bright / 0x2d;
-		b = ((palette >> 0) & 0x0f) * 0x11 * bright / 0x2d;
-
-		m_palette->set_pen_color(offset, rgb_t(r, g, b));
-	}
+	return rgb_t(r, g, b);
 }
 
-void cps1bl_no_brgt::fcrash_build_palette()
+rgb_t cps1bl_no_brgt::no_brgt_palette_colour(u16 palette)
 {
 	// some bootlegs don't have the brightness hardware, the 2x 74ls07 and 2x extra resistor arrays
 	// are either unpopulated or simply don't exist in the bootleg design.
 	// this is a problem as some games (wofabl, jurassic99) use erroneous brightness values
 	// which have no effect on the bootleg pcb, but cause issues in mame (as they would on genuine hardware).
+	int r, g, b;
 
-	int offset;
+	r = ((palette >> 8) & 0x0f) * 0x11;
+	g = ((palette >> 4) & 0x0f) * 0x11;
+	b = ((palette >> 0) & 0x0f) * 0x11;
 
-	// all the bootlegs seem to write the palette offset as usual
-	int palettebase = (m_cps_a_regs[0x0a / 2] << 8) & 0x1ffff;
+	return rgb_t(r, g, b);
+}
 
-	for (offset = 0; offset < 32 * 6 * 16; offset++)
-	{
-		int palette = m_gfxram[palettebase / 2 + offset];
-		int r, g, b;
+void fcrash_state::fcrash_build_palette()
+{
+	if (!m_palette_lut)
+		cps1_palette_lut_init();
 
-		r = ((palette >> 8) & 0x0f) * 0x11;
-		g = ((palette >> 4) & 0x0f) * 0x11;
-		b = ((palette >> 0) & 0x0f) * 0x11;
+	// all the bootlegs seem to write the palette offset as usual
+	int palettebase = (m_cps_a_regs[0x0a / 2] << 8) & 0x1ffff;
 
-		m_palette->set_pen_color(offset, rgb_t(r, g, b));
-	}
+	for (int page = 0; page < 6; page++)
+		cps1_palette_copy_page(page, palettebase / 2 + page * 0x200);
+	cps1_palette_copy_done();
 }
 
 uint32_t fcrash_state::screen_update_fcrash(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect)
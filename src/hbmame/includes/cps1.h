@@ -194,6 +194,30 @@ public:
 	int          m_stars2x = 0;
 	int          m_stars2y = 0;
 	int          m_last_sprite_offset = 0;      /* Offset of the last sprite */
+	struct sprite_tile
+	{
+		int code;   /* bank-mapped tile code */
+		int colour;
+		int flipx;
+		int flipy;
+		int sx;     /* unflipped screen position */
+		int sy;
+	};
+	std::vector<sprite_tile> m_sprite_list{}; /* one entry per 16x16 tile, in drawing order */
+	bool         m_sprite_list_valid = false;   /* m_sprite_list matches m_buffered_obj */
+	bitmap_ind16 m_sprite_check_bitmap{};       /* scratch bitmaps for CPS1_SPRITE_LIST_CHECK */
+	bitmap_ind8  m_sprite_check_priority{};
+
+	/* palette conversion */
+	rgb_t     (*m_palette_convert)(u16) = &cps_state::cps1_palette_colour; /* this board's colour formula */
+	std::unique_ptr<rgb_t []>   m_palette_lut{};    /* m_palette_convert for every colour word */
+	std::vector<u8> m_palette_ram_dirty{};      /* per 0x200 word page of gfxram, set by writes */
+	int          m_palette_source[6]{};         /* gfxram word offset last copied into each palette page (-1 = none) */
+
+	/* tilemap transparency masks */
+	int          m_transmask_cache[4] = { -1, -1, -1, -1 };  /* masks last given to the tilemaps (-1 = none) */
+	u32          m_transmask_rebuilds = 0;      /* updates that changed a mask, since the last report */
+	u32          m_transmask_skips = 0;         /* updates that found nothing to do */
 	int          m_pri_ctrl = 0;                /* Sprite layer priorities */
 	int          m_objram_bank = 0;
 
@@ -364,9 +388,19 @@ public:
 	void cps1_get_video_base();
 	int gfxrom_bank_mapper(int type, int code);
 	void cps1_update_transmasks();
+	void cps1_set_transmasks(const int (&masks)[4]);
 	void cps1_build_palette(const u16 * const palette_base);
+	static rgb_t cps1_palette_colour(u16 palette);
+	void cps1_palette_lut_init();
+	void cps1_palette_copy_page(int page, int source);
+	void cps1_palette_copy_done();
+	void cps1_palette_invalidate();
 	void cps1_find_last_sprite();
+	void cps1_build_sprite_list();
+	void cps1_invalidate_sprite_list() { m_sprite_list_valid = false; }
 	void cps1_render_sprites(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect);
+	void cps1_render_sprite_list(bitmap_ind16 &bitmap, bitmap_ind8 &primap, const rectangle &cliprect);
+	void cps1_render_sprites_direct(bitmap_ind16 &bitmap, bitmap_ind8 &primap, const rectangle &cliprect);
 	void cps1_render_stars(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect);
 	void cps1_render_layer(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect, int layer, int primask);
 	void cps1_render_high_layer(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect, int layer);
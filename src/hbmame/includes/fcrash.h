@@ -22,7 +22,9 @@ public:
 		, m_msm_2(*this, "msm2")
 		, m_okibank(*this, "okibank")
 		, m_sgyxz_dsw(*this, { "DSWA", "DSWB", "DSWC" })
-	{ }
+	{
+		m_palette_convert = &fcrash_state::fcrash_palette_colour;
+	}
 
 	void fcrash(machine_config &config);
 	void cawingbl(machine_config &config);
@@ -76,6 +78,7 @@ protected:
 	void fcrash_render_layer(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect, int layer, int primask);
 	void fcrash_render_high_layer(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect, int layer);
 	virtual void fcrash_build_palette();
+	static rgb_t fcrash_palette_colour(u16 palette);
 
 	void fcrash_map(address_map &map);
 	void mtwinsb_map(address_map &map);
@@ -122,10 +125,12 @@ class cps1bl_no_brgt : public fcrash_state
 public:
 	cps1bl_no_brgt(const machine_config &mconfig, device_type type, const char *tag)
 		: fcrash_state(mconfig, type, tag)
-	{ }
+	{
+		m_palette_convert = &cps1bl_no_brgt::no_brgt_palette_colour;
+	}
 
 private:
-	void fcrash_build_palette() override;
+	static rgb_t no_brgt_palette_colour(u16 palette);
 };
 
 #endif // MAME_INCLUDES_FCRASH_H
@@ -53,6 +53,10 @@ After that, the remainder of the file is binary zeroes.
 ********************************************************************/
 #define WRITE_FILE 0
 
+/* set to 1 to draw sprites both from the display list and directly from
+   the object buffer, and report any pixel that differs */
+#define CPS1_SPRITE_LIST_CHECK 0
+
 /* Game specific data */
 
 #define GFXTYPE_SPRITES   (1<<0)
@@ -2205,6 +2209,9 @@ void cps_state::cps1_gfxram_w(offs_t offset, u16 data, u16 mem_mask)
 	int page = (offset >> 7) & 0x3c0;
 	COMBINE_DATA(&m_gfxram[offset]);
 
+	if ((offset >> 9) < m_palette_ram_dirty.size())
+		m_palette_ram_dirty[offset >> 9] = 1;
+
 	if (page == (m_cps_a_regs[CPS1_SCROLL1_BASE] & 0x3c0))
 		m_bg_tilemap[0]->mark_tile_dirty(offset / 2 & 0x0fff);
 
@@ -2342,24 +2349,45 @@ TILE_GET_INFO_MEMBER(cps_state::get_tile2_info)
 
 
 
+/* Hand the masks to the tilemaps, but only the groups that have changed
+   since the last call */
+void cps_state::cps1_set_transmasks(const int (&masks)[4])
+{
+	bool changed = false;
+
+	for (int i = 0; i < 4; i++)
+	{
+		if (masks[i] == m_transmask_cache[i])
+			continue;
+
+		m_transmask_cache[i] = masks[i];
+		m_bg_tilemap[0]->set_transmask(i, masks[i], 0x8000);
+		m_bg_tilemap[1]->set_transmask(i, masks[i], 0x8000);
+		m_bg_tilemap[2]->set_transmask(i, masks[i], 0x8000);
+		changed = true;
+	}
+
+	if (changed)
+		m_transmask_rebuilds++;
+	else
+		m_transmask_skips++;
+}
+
 void cps_state::cps1_update_transmasks()
 {
 	int i;
+	int masks[4];
 
 	for (i = 0; i < 4; i++)
 	{
-		int mask;
-
 		/* Get transparency registers */
 		if (m_priority[i] != -1)
-			mask = m_cps_b_regs[m_priority[i] / 2] ^ 0xffff;
+			masks[i] = m_cps_b_regs[m_priority[i] / 2] ^ 0xffff;
 		else
-			mask = 0xffff;  /* completely transparent if priority masks not defined (qad) */
-
-		m_bg_tilemap[0]->set_transmask(i, mask, 0x8000);
-		m_bg_tilemap[1]->set_transmask(i, mask, 0x8000);
-		m_bg_tilemap[2]->set_transmask(i, mask, 0x8000);
+			masks[i] = 0xffff;  /* completely transparent if priority masks not defined (qad) */
 	}
+
+	cps1_set_transmasks(masks);
 }
 
 VIDEO_START_MEMBER(cps_state,cps)
@@ -2392,6 +2420,10 @@ VIDEO_START_MEMBER(cps_state,cps)
 
 	m_buffered_obj = make_unique_clear<u16[]>(m_obj_size / 2);
 
+	/* palette conversion tracks writes to gfxram in 0x200 word pages */
+	m_palette_ram_dirty.assign((m_gfxram.length() + 0x1ff) / 0x200, 1);
+	std::fill(std::begin(m_palette_source), std::end(m_palette_source), -1);
+
 	/* clear RAM regions */
 	memset(m_gfxram, 0, m_gfxram.bytes());   /* Clear GFX RAM */
 	memset(m_cps_a_regs, 0, 0x40);   /* Clear CPS-A registers */
@@ -2442,6 +2474,8 @@ VIDEO_START_MEMBER(cps_state,cps)
 	save_pointer(NAME(m_buffered_obj.get()), m_obj_size / 2);
 
 	machine().save().register_postload(save_prepost_delegate(FUNC(cps_state::cps1_get_video_base), this));
+	machine().save().register_postload(save_prepost_delegate(FUNC(cps_state::cps1_invalidate_sprite_list), this));
+	machine().save().register_postload(save_prepost_delegate(FUNC(cps_state::cps1_palette_invalidate), this));
 }
 
 VIDEO_START_MEMBER(cps_state,cps1)
@@ -2458,12 +2492,85 @@ VIDEO_START_MEMBER(cps_state,cps1)
 
 ***************************************************************************/
 
+rgb_t cps_state::cps1_palette_colour( u16 palette )
+{
+	int r, g, b, bright;
+
+	// from my understanding of the schematics, when the 'brightness'
+	// component is set to 0 it should reduce brightness to 1/3
+
+	// HBMAME start
+	u8 b_adj = 0x0f;
+	u8 b_div = 0x1e + b_adj;
+	bright = b_adj + ((palette >> 12) << 1);
+
+	// New code to get rid of grey squares
+	r = (palette >> 8) & 0x0f;
+	g = (palette >> 4) & 0x0f;
+	b = palette & 0x0f;
+	r = (r > 1) ? r * 0x11 * bright / b_div : 0;
+	g = (g > 1) ? g * 0x11 * bright / b_div : 0;
+	b = (b > 1) ? b * 0x11 * bright / b_div : 0;
+	// HBMAME end
+
+	return rgb_t(r, g, b);
+}
+
+
+/* Fill the colour lookup table for every possible palette word */
+void cps_state::cps1_palette_lut_init()
+{
+	m_palette_lut = std::make_unique<rgb_t []>(0x10000);
+	for (int palette = 0; palette < 0x10000; palette++)
+		m_palette_lut[palette] = m_palette_convert(palette);
+
+	cps1_palette_invalidate();
+}
+
+
+/* Forget what has been copied, so that every page is converted again */
+void cps_state::cps1_palette_invalidate()
+{
+	std::fill(std::begin(m_palette_source), std::end(m_palette_source), -1);
+	std::fill(m_palette_ram_dirty.begin(), m_palette_ram_dirty.end(), 1);
+}
+
+
+/* Convert one 0x200 entry palette page from gfxram, unless neither the
+   source address nor the gfxram it covers has changed since last time */
+void cps_state::cps1_palette_copy_page( int page, int source )
+{
+	const unsigned first = source >> 9;
+	const unsigned last = std::min<unsigned>((source + 0x1ff) >> 9, m_palette_ram_dirty.size() - 1);
+	bool dirty = (m_palette_source[page] != source);
+	for (unsigned i = first; !dirty && i <= last; i++)
+		dirty = m_palette_ram_dirty[i];
+	if (!dirty)
+		return;
+
+	m_palette_source[page] = source;
+	const u16 *palette_ram = &m_gfxram[source];
+	for (int offset = 0; offset < 0x200; ++offset)
+		m_palette->set_pen_color(0x200 * page + offset, m_palette_lut[palette_ram[offset]]);
+}
+
+
+/* Called once all pages have been considered */
+void cps_state::cps1_palette_copy_done()
+{
+	std::fill(m_palette_ram_dirty.begin(), m_palette_ram_dirty.end(), 0);
+}
+
+
 void cps_state::cps1_build_palette( const u16* const palette_base )
 {
-	int offset, page;
-	const u16 *palette_ram = palette_base;
+	int page;
+	int source = palette_base - &m_gfxram[0];
 	int ctrl = m_cps_b_regs[m_palette_control/2];
 
+	if (!m_palette_lut)
+		cps1_palette_lut_init();
+
 	/*
 	The palette is copied only for pages that are enabled in the ctrl
 	register. Note that if the first palette pages are skipped, all
@@ -2473,38 +2580,21 @@ void cps_state::cps1_build_palette( const u16* const palette_base )
 	{
 		if (BIT(ctrl, page))
 		{
-			for (offset = 0; offset < 0x200; ++offset)
-			{
-				int palette = *(palette_ram++);
-				int r, g, b, bright;
-
-				// from my understanding of the schematics, when the 'brightness'
-				// component is set to 0 it should reduce brightness to 1/3
-
-				// HBMAME start
-				u8 b_adj = 0x0f;
-				u8 b_div = 0x1e + b_adj;
-				bright = b_adj + ((palette >> 12) << 1);
-
-				// New code to get rid of grey squares
-				r = (palette >> 8) & 0x0f;
-				g = (palette >> 4) & 0x0f;
-				b = palette & 0x0f;
-				r = (r > 1) ? r * 0x11 * bright / b_div : 0;
-				g = (g > 1) ? g * 0x11 * bright / b_div : 0;
-				b = (b > 1) ? b * 0x11 * bright / b_div : 0;
-				// HBMAME end
-
-				m_palette->set_pen_color (0x200 * page + offset, rgb_t(r, g, b));
-			}
+			cps1_palette_copy_page(page, source);
+			source += 0x200;
 		}
 		else
 		{
+			// a page that is not copied keeps its old colours, but must be
+			// converted again the next time it is enabled
+			m_palette_source[page] = -1;
+
 			// skip page in gfxram, but only if we have already copied at least one page
-			if (palette_ram != palette_base)
-				palette_ram += 0x200;
+			if (source != palette_base - &m_gfxram[0])
+				source += 0x200;
 		}
 	}
+	cps1_palette_copy_done();
 }
 
 
@@ -2578,7 +2668,133 @@ void cps_state::cps1_find_last_sprite()    /* Find the offset of last sprite */
 }
 
 
+/* Walk the buffered object RAM once, resolving the bank mapping and
+   expanding blocked sprites into individual tiles */
+void cps_state::cps1_build_sprite_list()
+{
+	int i, baseadd;
+	u16 *base = m_buffered_obj.get();
+
+	cps1_find_last_sprite();
+	m_sprite_list.clear();
+	m_sprite_list_valid = true;
+
+	/* some sf2 hacks draw the sprites in reverse order */
+	if (BIT(m_bootleg_kludge, 6)) // HBMAME
+	{
+		base += m_last_sprite_offset;
+		baseadd = -4;
+	}
+	else
+	{
+		baseadd = 4;
+	}
+
+	for (i = m_last_sprite_offset; i >= 0; i -= 4, base += baseadd)
+	{
+		int x = *(base + 0);
+		int y = *(base + 1);
+		int code = gfxrom_bank_mapper(GFXTYPE_SPRITES, *(base + 2));
+		int colour = *(base + 3);
+		int col = colour & 0x1f;
+
+		if (code == -1)
+			continue;
+
+		if (colour & 0xff00)
+		{
+			/* handle blocked sprites */
+			int nx = ((colour & 0x0f00) >> 8) + 1;
+			int ny = ((colour & 0xf000) >> 12) + 1;
+			int flipx = BIT(colour, 5);
+			int flipy = BIT(colour, 6);
+
+			for (int nys = 0; nys < ny; nys++)
+			{
+				int row = flipy ? (ny - 1 - nys) : nys;
+				for (int nxs = 0; nxs < nx; nxs++)
+				{
+					int column = flipx ? ((nx - 1) - nxs) : nxs;
+					m_sprite_list.push_back(sprite_tile{
+							(code & ~0xf) + ((code + column) & 0xf) + 0x10 * row,
+							col,
+							flipx, flipy,
+							(x + nxs * 16) & 0x1ff, (y + nys * 16) & 0x1ff });
+				}
+			}
+		}
+		else
+		{
+			/* Simple case... 1 sprite */
+			m_sprite_list.push_back(sprite_tile{ code, col, BIT(colour, 5), BIT(colour, 6), x & 0x1ff, y & 0x1ff });
+		}
+	}
+}
+
+
+/* Draw the tiles from the display list that touch the clip rectangle;
+   raster effects can make this run many times per frame */
+void cps_state::cps1_render_sprite_list( bitmap_ind16 &bitmap, bitmap_ind8 &primap, const rectangle &cliprect )
+{
+	gfx_element *const gfx = m_gfxdecode->gfx(2);
+	const bool flip = flip_screen();
+
+	for (const sprite_tile &tile : m_sprite_list)
+	{
+		int sx = flip ? (512 - 16 - tile.sx) : tile.sx;
+		int sy = flip ? (256 - 16 - tile.sy) : tile.sy;
+
+		if (sy > cliprect.bottom() || sy + 15 < cliprect.top() || sx > cliprect.right() || sx + 15 < cliprect.left())
+			continue;
+
+		gfx->prio_transpen(bitmap, cliprect,
+				tile.code,
+				tile.colour,
+				flip ? !tile.flipx : tile.flipx,
+				flip ? !tile.flipy : tile.flipy,
+				sx, sy, primap, 0x02, 15);
+	}
+}
+
+
 void cps_state::cps1_render_sprites( screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect )
+{
+	if (!m_sprite_list_valid)
+		cps1_build_sprite_list();
+
+	if (CPS1_SPRITE_LIST_CHECK)
+	{
+		/* draw the old way into copies of the destination */
+		if (m_sprite_check_bitmap.width() != bitmap.width() || m_sprite_check_bitmap.height() != bitmap.height())
+		{
+			m_sprite_check_bitmap.allocate(bitmap.width(), bitmap.height());
+			m_sprite_check_priority.allocate(bitmap.width(), bitmap.height());
+		}
+		for (int y = cliprect.top(); y <= cliprect.bottom(); y++)
+		{
+			std::copy_n(&bitmap.pix(y, cliprect.left()), cliprect.width(), &m_sprite_check_bitmap.pix(y, cliprect.left()));
+			std::copy_n(&screen.priority().pix(y, cliprect.left()), cliprect.width(), &m_sprite_check_priority.pix(y, cliprect.left()));
+		}
+		cps1_render_sprites_direct(m_sprite_check_bitmap, m_sprite_check_priority, cliprect);
+	}
+
+	cps1_render_sprite_list(bitmap, screen.priority(), cliprect);
+
+	if (CPS1_SPRITE_LIST_CHECK)
+	{
+		int mismatches = 0;
+		for (int y = cliprect.top(); y <= cliprect.bottom(); y++)
+			for (int x = cliprect.left(); x <= cliprect.right(); x++)
+				if (bitmap.pix(y, x) != m_sprite_check_bitmap.pix(y, x) || screen.priority().pix(y, x) != m_sprite_check_priority.pix(y, x))
+					mismatches++;
+
+		if (mismatches)
+			logerror("Sprite display list differs from direct render: %d pixels, frame %d, lines %d-%d\n",
+					mismatches, int(screen.frame_number()), cliprect.top(), cliprect.bottom());
+	}
+}
+
+void cps_state::cps1_render_sprites_direct( bitmap_ind16 &bitmap, bitmap_ind8 &primap, const rectangle &cliprect )
 {
 #define DRAWSPRITE(CODE,COLOR,FLIPX,FLIPY,SX,SY)                    \
 {                                                                   \
@@ -2588,14 +2804,14 @@ void cps_state::cps1_render_sprites( screen_device &screen, bitmap_ind16 &bitmap
 				CODE,                                               \
 				COLOR,                                              \
 				!(FLIPX),!(FLIPY),                                  \
-				512-16-(SX),256-16-(SY),    screen.priority(),0x02,15);                   \
+				512-16-(SX),256-16-(SY),    primap,0x02,15);                   \
 	else                                                            \
 		m_gfxdecode->gfx(2)->prio_transpen(bitmap,\
 				cliprect,                            \
 				CODE,                                               \
 				COLOR,                                              \
 				FLIPX,FLIPY,                                        \
-				SX,SY, screen.priority(),0x02,15);          \
+				SX,SY, primap,0x02,15);          \
 }
 
 
@@ -2925,6 +3141,14 @@ WRITE_LINE_MEMBER(cps_state::screen_vblank_cps1)
 
 		/* CPS1 sprites have to be delayed one frame */
 		memcpy(m_buffered_obj.get(), m_obj, m_obj_size);
+		cps1_build_sprite_list();
+
+		/* report how often the transparency masks really changed */
+		if ((m_screen->frame_number() % 600) == 599)
+		{
+			logerror("Transparency masks: %u updates rebuilt, %u skipped in the last 600 frames\n", m_transmask_rebuilds, m_transmask_skips);
+			m_transmask_rebuilds = m_transmask_skips = 0;
+		}
 	}
 }
 
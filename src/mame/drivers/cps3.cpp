@@ -587,6 +587,7 @@ Hardware registers info
 #include "machine/wd33c9x.h"
 #include "screen.h"
 #include "speaker.h"
+#include "parallel.h"
 
 #include <algorithm>
 
@@ -609,6 +610,62 @@ enum
 	CPS3_TRANSPARENCY_PEN_INDEX_BLEND
 };
 
+/* Runs op(dest pixel, source pen) over the clipped destination area.
+   The source column of each destination column is the same on every row,
+   so it is either stepped by one (the 1:1 case, which covers nearly every
+   tile) or taken from a table built once per tile. Both give exactly the
+   columns the 16.16 stepping would. */
+template <typename Op>
+static inline void cps3_blit(bitmap_rgb32 &dest_bmp, const u8 *source_base, u32 rowbytes,
+		int sx, int sy, int ex, int ey, int x_index_base, int y_index, int dx, int dy, Op &&op)
+{
+	const int width = ex - sx;
+
+	if (dx == 0x10000 || dx == -0x10000)
+	{
+		const u8 *const first = source_base + (x_index_base >> 16);
+		for (int y = sy; y < ey; y++)
+		{
+			u8 const *const source = first + (y_index >> 16) * rowbytes;
+			u32 *const dest = &dest_bmp.pix(y, sx);
+
+			if (dx > 0)
+			{
+				for (int i = 0; i < width; i++)
+					op(dest[i], source[i]);
+			}
+			else
+			{
+				for (int i = 0; i < width; i++)
+					op(dest[i], source[-i]);
+			}
+			y_index += dy;
+		}
+	}
+	else
+	{
+		u8 xmap[1024];
+		const int mapped = std::min<int>(width, ARRAY_LENGTH(xmap));
+		int x_index = x_index_base;
+		for (int i = 0; i < mapped; i++, x_index += dx)
+			xmap[i] = x_index >> 16;
+
+		for (int y = sy; y < ey; y++)
+		{
+			u8 const *const source = source_base + (y_index >> 16) * rowbytes;
+			u32 *const dest = &dest_bmp.pix(y, sx);
+
+			for (int i = 0; i < mapped; i++)
+				op(dest[i], source[xmap[i]]);
+
+			// only reached for areas wider than any CPS3 bitmap
+			for (int i = mapped, xi = x_index; i < width; i++, xi += dx)
+				op(dest[i], source[xi >> 16]);
+			y_index += dy;
+		}
+	}
+}
+
 inline void cps3_state::cps3_drawgfxzoom(bitmap_rgb32 &dest_bmp,const rectangle &clip,gfx_element *gfx,
 		u32 code,u32 color,int flipx,int flipy,int sx,int sy,
 		int transparency,int transparent_color,
@@ -620,12 +677,7 @@ inline void cps3_state::cps3_drawgfxzoom(bitmap_rgb32 &dest_bmp,const rectangle
 
 	if (!scalex || !scaley) return;
 
-// todo: reimplement this optimization!!
-//  if (scalex == 0x10000 && scaley == 0x10000)
-//  {
-//      cps3_drawgfx(dest_bmp,gfx,code,color,flipx,flipy,sx,sy,clip,transparency,transparent_color);
-//      return;
-//  }
+	// 1:1 tiles are handled by the unscaled path in cps3_blit
 
 	/*
 	scalex and scaley are 16.16 fixed point numbers
@@ -708,93 +760,40 @@ inline void cps3_state::cps3_drawgfxzoom(bitmap_rgb32 &dest_bmp,const rectangle
 
 				if (ex > sx)
 				{ /* skip if inner loop doesn't draw anything */
+					const u32 rowbytes = gfx->rowbytes();
 					if (transparency == CPS3_TRANSPARENCY_NONE)
 					{
-						for (int y = sy; y < ey; y++)
-						{
-							u8 const *const source = source_base + (y_index>>16) * gfx->rowbytes();
-							u32 *const dest = &dest_bmp.pix(y);
-
-							int x_index = x_index_base;
-							for (int x = sx; x < ex; x++)
-							{
-								dest[x] = pal[source[x_index>>16]];
-								x_index += dx;
-							}
-							y_index += dy;
-						}
+						cps3_blit(dest_bmp, source_base, rowbytes, sx, sy, ex, ey, x_index_base, y_index, dx, dy,
+								[pal] (u32 &dest, u8 c) { dest = pal[c]; });
 					}
 					else if (transparency == CPS3_TRANSPARENCY_PEN)
 					{
-						for (int y = sy; y < ey; y++)
-						{
-							u8 const *const source = source_base + (y_index>>16) * gfx->rowbytes();
-							u32 *const dest = &dest_bmp.pix(y);
-
-							int x_index = x_index_base;
-							for (int x = sx; x < ex; x++)
-							{
-								int c = source[x_index>>16];
-								if (c != transparent_color) dest[x] = pal[c];
-								x_index += dx;
-							}
-							y_index += dy;
-						}
+						cps3_blit(dest_bmp, source_base, rowbytes, sx, sy, ex, ey, x_index_base, y_index, dx, dy,
+								[pal, transparent_color] (u32 &dest, u8 c) { if (c != transparent_color) dest = pal[c]; });
 					}
 					else if (transparency == CPS3_TRANSPARENCY_PEN_INDEX)
 					{
-						for (int y = sy; y < ey; y++)
-						{
-							u8 const *const source = source_base + (y_index>>16) * gfx->rowbytes();
-							u32 *const dest = &dest_bmp.pix(y);
-
-							int x_index = x_index_base;
-							for (int x = sx; x < ex; x++)
-							{
-								int c = source[x_index>>16];
-								if (c != transparent_color) dest[x] = c | palbase;
-								x_index += dx;
-							}
-							y_index += dy;
-						}
+						cps3_blit(dest_bmp, source_base, rowbytes, sx, sy, ex, ey, x_index_base, y_index, dx, dy,
+								[palbase, transparent_color] (u32 &dest, u8 c) { if (c != transparent_color) dest = c | palbase; });
 					}
 					else if (transparency == CPS3_TRANSPARENCY_PEN_INDEX_BLEND)
 					{
-						for (int y = sy; y < ey; y++)
+						/* blending isn't 100% understood */
+						// is it really ORed or bits should be replaced same as in Seta/SSV hardware ? both produce same results in games
+						// (replacing would be dest = (dest & 0x01fff) | ... and dest = (dest & 0x07fff) | ... respectively)
+						// the blend operations are written without branches so the compiler can vectorise the unscaled rows
+						if (gfx->granularity() == 64)
 						{
-							u8 const *const source = source_base + (y_index>>16) * gfx->rowbytes();
-							u32 *const dest = &dest_bmp.pix(y);
-
-							int x_index = x_index_base;
-							for (int x = sx; x < ex; x++)
-							{
-								int c = source[x_index>>16];
-								if (c != transparent_color)
-								{
-									/* blending isn't 100% understood */
-									// is it really ORed or bits should be replaced same as in Seta/SSV hardware ? both produce same results in games
-									if (gfx->granularity() == 64)
-									{
-										// OK for sfiii world map spotlight
-#if 1
-										dest[x] |= (c & 0xf) << 13;
-#else
-										dest[x] = (dest[x] & 0x01fff) | ((c & 0xf) << 13);
-#endif
-									}
-									else
-									{
-										// OK for jojo intro, and warzard swords, and various shadows in sf games
-#if 1
-										dest[x] |= ((c & 1) << 15) | ((color & 1) << 16);
-#else
-										dest[x] = (dest[x] & 0x07fff) | ((c & 1) << 15) | ((color & 1) << 16);
-#endif
-									}
-								}
-								x_index += dx;
-							}
-							y_index += dy;
+							// OK for sfiii world map spotlight
+							cps3_blit(dest_bmp, source_base, rowbytes, sx, sy, ex, ey, x_index_base, y_index, dx, dy,
+									[transparent_color] (u32 &dest, u8 c) { dest |= (c != transparent_color) ? ((c & 0xf) << 13) : 0; });
+						}
+						else
+						{
+							// OK for jojo intro, and warzard swords, and various shadows in sf games
+							const u32 colourbits = (color & 1) << 16;
+							cps3_blit(dest_bmp, source_base, rowbytes, sx, sy, ex, ey, x_index_base, y_index, dx, dy,
+									[transparent_color, colourbits] (u32 &dest, u8 c) { dest |= (c != transparent_color) ? (((c & 1) << 15) | colourbits) : 0; });
 						}
 					}
 				}
@@ -807,54 +806,73 @@ inline void cps3_state::cps3_drawgfxzoom(bitmap_rgb32 &dest_bmp,const rectangle
 
 /* Encryption */
 
-
-u16 cps3_state::rotate_left(u16 value, int n)
-{
-	int aux = value>>(16-n);
-	return ((value<<n)|aux)%0x10000;
-}
-
-u16 cps3_state::rotxor(u16 val, u16 xorval)
+/* The mask for a word depends only on its address and the two keys. These
+   are written with plain shifts so that the block loop below has no calls
+   or branches and the compiler can vectorise it. */
+static inline u16 cps3_rotxor(u16 val, u16 xorval)
 {
-	u16 res = val + rotate_left(val,2);
+	u16 res = val + u16((val << 2) | (val >> 14));
 
-	res = rotate_left(res,4) ^ (res & (val ^ xorval));
+	res = u16((res << 4) | (res >> 12)) ^ (res & (val ^ xorval));
 
 	return res;
 }
 
-u32 cps3_state::cps3_mask(u32 address, u32 key1, u32 key2)
+static inline u32 cps3_crypt_mask(u32 address, u32 key1, u32 key2)
 {
-	// ignore all encryption
-	if (m_altEncryption == 2)
-		return 0;
-
 	address ^= key1;
 
 	u16 val = (address & 0xffff) ^ 0xffff;
 
-	val = rotxor(val, key2 & 0xffff);
+	val = cps3_rotxor(val, key2 & 0xffff);
 
 	val ^= (address >> 16) ^ 0xffff;
 
-	val = rotxor(val, key2 >> 16);
+	val = cps3_rotxor(val, key2 >> 16);
 
 	val ^= (address & 0xffff) ^ (key2 & 0xffff);
 
 	return val | (val << 16);
 }
 
+// dest[i] = src[i] ^ mask of (address + i*4); dest may be src
+static void cps3_decrypt_words(u32 *dest, const u32 *src, u32 count, u32 address, u32 key1, u32 key2)
+{
+	for (u32 i = 0; i < count; i++)
+		dest[i] = src[i] ^ cps3_crypt_mask(address + i*4, key1, key2);
+}
+
+// split a decrypt across the work queue; slices never overlap
+static void cps3_decrypt_words_threaded(u32 *dest, const u32 *src, u32 count, u32 address, u32 key1, u32 key2)
+{
+	// below this, queueing a slice costs more than it saves
+	parallel_for(count, 0x10000, [=] (u32 start, u32 end)
+			{
+				cps3_decrypt_words(dest + start, src + start, end - start, address + start*4, key1, key2);
+			});
+}
+
+u16 cps3_state::rotxor(u16 val, u16 xorval)
+{
+	return cps3_rotxor(val, xorval);
+}
+
+u32 cps3_state::cps3_mask(u32 address, u32 key1, u32 key2)
+{
+	// ignore all encryption
+	if (m_altEncryption == 2)
+		return 0;
+
+	return cps3_crypt_mask(address, key1, key2);
+}
+
 void cps3_state::decrypt_bios()
 {
 	u32 *coderegion = (u32*)memregion("bios")->base();
 	u32 codelength = memregion("bios")->bytes();
 
-	for (int i = 0; i<codelength; i +=4)
-	{
-		u32 dword = coderegion[i/4];
-		u32 xormask = cps3_mask(i, m_key1, m_key2);
-		coderegion[i/4] = dword ^ xormask;
-	}
+	if (m_altEncryption != 2)
+		cps3_decrypt_words_threaded(coderegion, coderegion, codelength/4, 0, m_key1, m_key2);
 #if 0
 	/* Dump to file */
 	{
@@ -1857,6 +1875,65 @@ void cps3_state::palettedma_w(offs_t offset, u32 data, u32 mem_mask)
 //static u8* current_table;
 
 
+/* Character RAM tiles written by one DMA. Marking the gfx element dirty
+   for every decompressed byte costs more than the decompression itself,
+   so the tiles are collected here and each one is marked once when the
+   transfer is over. */
+class cps3_char_dirty
+{
+public:
+	cps3_char_dirty() : m_lo(WORDS), m_hi(0) { std::fill(std::begin(m_bits), std::end(m_bits), 0); }
+
+	// note bytes [start, start + length) of character RAM, wrapping at 8MB
+	void mark(u32 start, u32 length)
+	{
+		if (!length)
+			return;
+		if (length >= 0x800000)
+			start = 0, length = 0x800000;
+		start &= 0x7fffff;
+		if (start + length > 0x800000)
+		{
+			mark_tiles(0, (start + length - 0x800000 - 1) >> 8);
+			length = 0x800000 - start;
+		}
+		mark_tiles(start >> 8, (start + length - 1) >> 8);
+	}
+
+	// mark every noted tile dirty and start over
+	void flush(gfx_element &gfx)
+	{
+		for (u32 word = m_lo; word < m_hi; word++)
+		{
+			u64 bits = m_bits[word];
+			m_bits[word] = 0;
+			for (u32 tile = word * 64; bits; tile++, bits >>= 1)
+				if (bits & 1)
+					gfx.mark_dirty(tile);
+		}
+		m_lo = WORDS;
+		m_hi = 0;
+	}
+
+private:
+	static constexpr u32 WORDS = (0x800000 / 0x100) / 64;
+
+	void mark_tiles(u32 first, u32 last)
+	{
+		for (u32 tile = first; tile <= last; )
+		{
+			u32 const bit = tile & 63;
+			u32 const count = std::min(last - tile + 1, 64 - bit);
+			m_bits[tile >> 6] |= ((count == 64) ? ~u64(0) : ((u64(1) << count) - 1)) << bit;
+			tile += count;
+		}
+		m_lo = std::min(m_lo, first >> 6);
+		m_hi = std::max(m_hi, (last >> 6) + 1);
+	}
+
+	u64 m_bits[WORDS];
+	u32 m_lo, m_hi;     // range of words that may have bits set
+};
 
 
 u32 cps3_state::process_byte( u8 real_byte, u32 destination, int max_length )
@@ -1867,38 +1944,31 @@ u32 cps3_state::process_byte( u8 real_byte, u32 destination, int max_length )
 
 	destination&=0x7fffff;
 
+	// the caller marks the written tiles dirty
 	if (real_byte & 0x40)
 	{
-		int tranfercount = 0;
-
 		//logerror("Set RLE Mode\n");
-		m_rle_length = (real_byte & 0x3f)+1;
+		u32 const run = (real_byte & 0x3f)+1;
+		u32 const tranfercount = std::min<u32>(run, 0x800000 - destination);
+		u8 const value = m_last_normal_byte & 0x3f;
 
-		//logerror("RLE Operation (length %08x\n", m_rle_length );
+		//logerror("RLE Operation (length %08x\n", run );
 
-		while (m_rle_length)
-		{
-			dest[((destination+tranfercount) & 0x7fffff)^3] = (m_last_normal_byte & 0x3f);
-			m_gfxdecode->gfx(1)->mark_dirty(((destination+tranfercount) & 0x7fffff)/0x100);
-			//logerror("RLE WRite Byte %08x, %02x\n", destination+tranfercount, real_byte);
+		for (u32 i = 0; i < tranfercount; i++)
+			dest[(destination+i)^3] = value;
+		m_rle_length = run - tranfercount;
 
-			tranfercount++;
-			m_rle_length--;
-			max_length--;
+		// running into the end of character RAM returns what is left of max_length
+		if ((destination+tranfercount) > 0x7fffff)  return max_length - tranfercount;
 
-			if ((destination+tranfercount) > 0x7fffff)  return max_length;
-
-
-	//      if (max_length==0) return max_length; // this is meant to abort the transfer if we exceed dest length,, not working
-		}
+	//  if (max_length==0) return max_length; // this is meant to abort the transfer if we exceed dest length,, not working
 		return tranfercount;
 	}
 	else
 	{
 		//logerror("Write Normal Data\n");
-		dest[(destination & 0x7fffff)^3] = real_byte;
+		dest[destination^3] = real_byte;
 		m_last_normal_byte = real_byte;
-		m_gfxdecode->gfx(1)->mark_dirty((destination & 0x7fffff)/0x100);
 		return 1;
 	}
 }
@@ -1906,81 +1976,74 @@ u32 cps3_state::process_byte( u8 real_byte, u32 destination, int max_length )
 void cps3_state::do_char_dma( u32 real_source, u32 real_destination, u32 real_length )
 {
 	u8* sourcedata = (u8*)m_user5;
+	cps3_char_dirty dirty;
 	int length_remaining;
 
 	m_last_normal_byte = 0;
 	m_rle_length = 0;
 	length_remaining = real_length;
-	while (length_remaining)
+
+	// decompress one byte, returning false once the transfer has finished
+	auto const process = [&] (u8 real_byte) -> bool
 	{
-		u8 current_byte;
+		u32 const start = real_destination & 0x7fffff;
+		u32 const length_processed = process_byte(real_byte, real_destination, length_remaining );
+
+		// a literal writes one byte, a run stops at the end of character RAM
+		dirty.mark(start, (real_byte & 0x40) ? std::min<u32>((real_byte & 0x3f) + 1, 0x800000 - start) : 1);
+
+		length_remaining-=length_processed; // subtract the number of bytes the operation has taken
+		real_destination+=length_processed; // add it onto the destination
+		return (real_destination <= 0x7fffff) && (length_remaining > 0); // if we've expired, exit
+	};
 
-		current_byte = sourcedata[DMA_XOR(real_source)];
+	while (length_remaining)
+	{
+		u8 const current_byte = sourcedata[DMA_XOR(real_source)];
 		real_source++;
 
 		if (current_byte & 0x80)
 		{
-			u8 real_byte;
-			u32 length_processed;
-			current_byte &= 0x7f;
-
-			real_byte = sourcedata[DMA_XOR((m_current_table_address+current_byte*2+0))];
-			//if (real_byte & 0x80) return;
-			length_processed = process_byte(real_byte, real_destination, length_remaining );
-			length_remaining-=length_processed; // subtract the number of bytes the operation has taken
-			real_destination+=length_processed; // add it onto the destination
-			if (real_destination>0x7fffff) return;
-			if (length_remaining<=0) return; // if we've expired, exit
+			u32 const table = m_current_table_address + (current_byte & 0x7f)*2;
 
-			real_byte = sourcedata[DMA_XOR((m_current_table_address+current_byte*2+1))];
 			//if (real_byte & 0x80) return;
-			length_processed = process_byte(real_byte, real_destination, length_remaining );
-			length_remaining-=length_processed; // subtract the number of bytes the operation has taken
-			real_destination+=length_processed; // add it onto the destination
-			if (real_destination>0x7fffff) return;
-			if (length_remaining<=0) return;  // if we've expired, exit
+			if (!process(sourcedata[DMA_XOR(table+0)]))
+				break;
+			if (!process(sourcedata[DMA_XOR(table+1)]))
+				break;
 		}
-		else
+		else if (!process(current_byte))
 		{
-			u32 length_processed;
-			length_processed = process_byte(current_byte, real_destination, length_remaining );
-			length_remaining-=length_processed; // subtract the number of bytes the operation has taken
-			real_destination+=length_processed; // add it onto the destination
-			if (real_destination>0x7fffff) return;
-			if (length_remaining<=0) return;  // if we've expired, exit
+			break;
 		}
 
 //      length_remaining--;
 	}
+
+	dirty.flush(*m_gfxdecode->gfx(1));
 }
 
 u32 cps3_state::ProcessByte8(u8 b,u32 dst_offset)
 {
 	u8* destRAM = (u8*)m_char_ram.get();
-	int l=0;
 
+	// the caller marks the written tiles dirty
 	if (m_lastb==m_lastb2) //rle
 	{
 		int rle=(b+1) & 0xff;
+		u8 const value = m_lastb;
 
-		for (int i = 0; i<rle; ++i)
-		{
-			destRAM[(dst_offset & 0x7fffff)^3] = m_lastb;
-			m_gfxdecode->gfx(1)->mark_dirty((dst_offset & 0x7fffff)/0x100);
-
-			dst_offset++;
-			++l;
-		}
+		for (int i = 0; i<rle; ++i, ++dst_offset)
+			destRAM[(dst_offset & 0x7fffff)^3] = value;
 		m_lastb2=0xffff;
 
-		return l;
+		return rle;
 	}
 	else
 	{
 		m_lastb2=m_lastb;
 		m_lastb=b;
 		destRAM[(dst_offset & 0x7fffff)^3] = b;
-		m_gfxdecode->gfx(1)->mark_dirty((dst_offset & 0x7fffff)/0x100);
 		return 1;
 	}
 }
@@ -1990,10 +2053,18 @@ void cps3_state::do_alt_char_dma( u32 src, u32 real_dest, u32 real_length )
 	u8* px = (u8*)m_user5;
 	u32 start = real_dest;
 	u32 ds = real_dest;
+	cps3_char_dirty dirty;
 
 	m_lastb=0xfffe;
 	m_lastb2=0xffff;
 
+	auto const process = [&] (u8 b)
+	{
+		u32 const length = ProcessByte8(b,ds);
+		dirty.mark(ds, length);
+		ds+=length;
+	};
+
 	while(1)
 	{
 		u8 ctrl=px[DMA_XOR(src)];
@@ -2005,22 +2076,22 @@ void cps3_state::do_alt_char_dma( u32 src, u32 real_dest, u32 real_length )
 
 			if (ctrl & 0x80)
 			{
-				u8 real_byte;
-				p&=0x7f;
-				real_byte = px[DMA_XOR((m_current_table_address+p*2+0))];
-				ds+=ProcessByte8(real_byte,ds);
-				real_byte = px[DMA_XOR((m_current_table_address+p*2+1))];
-				ds+=ProcessByte8(real_byte,ds);
+				u32 const table = m_current_table_address + (p & 0x7f)*2;
+				process(px[DMA_XOR(table+0)]);
+				process(px[DMA_XOR(table+1)]);
 			}
 			else
 			{
-				ds+=ProcessByte8(p,ds);
+				process(p);
 			}
 			++src;
 			ctrl<<=1;
 
 			if ((ds-start)>=real_length)
+			{
+				dirty.flush(*m_gfxdecode->gfx(1));
 				return;
+			}
 		}
 	}
 }
@@ -2061,12 +2132,16 @@ void cps3_state::process_character_dma(u32 address)
 			break;
 		case 0: // not compressed DMA
 			// warzard use this at stage's start, code looks intent, not a game bug
-			for (u8* dest = (u8*)m_char_ram.get(); real_length; --real_length)
 			{
-				dest[(real_destination & 0x7fffff) ^ 3] = m_user5[DMA_XOR(real_source)];
-				m_gfxdecode->gfx(1)->mark_dirty((real_destination & 0x7fffff) / 0x100);
-				real_source++;
-				real_destination++;
+				cps3_char_dirty dirty;
+				dirty.mark(real_destination, real_length);
+				for (u8* dest = (u8*)m_char_ram.get(); real_length; --real_length)
+				{
+					dest[(real_destination & 0x7fffff) ^ 3] = m_user5[DMA_XOR(real_source)];
+					real_source++;
+					real_destination++;
+				}
+				dirty.flush(*m_gfxdecode->gfx(1));
 			}
 			break;
 		default:
@@ -2334,33 +2409,36 @@ void cps3_state::copy_from_nvram()
 {
 	u32* romdata = (u32*)m_user4;
 	u32* romdata2 = (u32*)m_decrypted_gamerom;
-	/* copy + decrypt program roms which have been loaded from flashroms/nvram */
+	/* copy program roms which have been loaded from flashroms/nvram */
 	for (u32 i = 0; i < 0x800000; i +=4)
 	{
 		u32 data;
 
 		data = ((m_simm[0][0]->read_raw(i/4)<<24) | (m_simm[0][1]->read_raw(i/4)<<16) | (m_simm[0][2]->read_raw(i/4)<<8) | (m_simm[0][3]->read_raw(i/4)<<0));
 
-	//  logerror("%08x %08x %08x %08x\n",romdata[i/4],data, romdata2[i/4], data ^ cps3_mask(i+0x6000000, m_key1, m_key2));
 		romdata[i/4] = data;
-		romdata2[i/4] = data ^ cps3_mask(i+0x6000000, m_key1, m_key2);
-
 	}
 
-	romdata  += 0x800000/4;
-	romdata2 += 0x800000/4;
+	u32 program_words = 0x800000/4;
 
 	if (m_simm[1][0] != nullptr)
+	{
 		for (u32 i = 0; i < 0x800000; i +=4)
 		{
 			u32 data;
 
 			data = ((m_simm[1][0]->read_raw(i/4)<<24) | (m_simm[1][1]->read_raw(i/4)<<16) | (m_simm[1][2]->read_raw(i/4)<<8) | (m_simm[1][3]->read_raw(i/4)<<0));
 
-		//  logerror("%08x %08x %08x %08x\n",romdata[i/4],data, romdata2[i/4],  data ^ cps3_mask(i+0x6800000, m_key1, m_key2) );
-			romdata[i/4] = data;
-			romdata2[i/4] = data ^ cps3_mask(i+0x6800000, m_key1, m_key2);
+			romdata[0x800000/4 + i/4] = data;
 		}
+		program_words += 0x800000/4;
+	}
+
+	/* decrypt them into the region we execute from; both SIMMs are one contiguous range from 0x6000000 */
+	if (m_altEncryption == 2)
+		std::copy_n(romdata, program_words, romdata2);
+	else
+		cps3_decrypt_words_threaded(romdata2, romdata, program_words, 0x6000000, m_key1, m_key2);
 
 	/* copy gfx from loaded flashroms to user reigon 5, where it's used */
 	{
@@ -132,6 +132,13 @@ Notes:
 
 #include "speaker.h"
 
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DDENLOVR_COMPOSE_SSE2 1
+#endif
+
 
 /***************************************************************************
 
@@ -372,8 +379,9 @@ protected:
 	void blitter_w_funkyfig(int blitter, offs_t offset, uint8_t data);
 private:
 	void do_plot( int x, int y, int pen );
+	void plot_span( int x, int y, int xinc, int count, int pen, const uint8_t *pens );
 	inline void log_draw_error( int src, int cmd );
-	void copylayer(bitmap_rgb32 &bitmap, const rectangle &cliprect, int layer);
+	void copylayers(bitmap_rgb32 &bitmap, const rectangle &cliprect, const int *layers, int count);
 
 	void akamaru_map(address_map &map);
 	void ddenlovj_map(address_map &map);
@@ -845,6 +853,119 @@ void ddenlovr_state::do_plot( int x, int y, int pen )
 	if (m_ddenlovr_dest_layer & 0x0800) m_ddenlovr_pixmap[7][addr] = pen;
 }
 
+/*  Span versions of do_plot's clipping: pixels outside lo-hi are drawn when
+    bit 0 of ctrl is set, pixels inside when bit 1 is.
+*/
+static inline bool ddenlovr_clip_accepts( int v, int lo, int hi, int ctrl )
+{
+	const bool outside = (v < lo) || (v > hi);
+	return ctrl & (outside ? 1 : 2);
+}
+
+static int ddenlovr_clip_runs( int lo, int hi, int ctrl, int *run_lo, int *run_hi )
+{
+	int runs = 0;
+	auto const add = [&] (int a, int b)
+	{
+		a = std::max(a, 0);
+		b = std::min(b, 0x1ff);
+		if (a <= b)
+		{
+			run_lo[runs] = a;
+			run_hi[runs] = b;
+			runs++;
+		}
+	};
+
+	if ((ctrl & 3) == 3)
+		add(0, 0x1ff);
+	else if (ctrl & 2)
+		add(lo, hi);
+	else if (ctrl & 1)
+	{
+		add(0, lo - 1);
+		add(hi + 1, 0x1ff);
+	}
+	return runs;
+}
+
+/*  Plot count pixels along the blitter X axis from (x, y), stepping by xinc
+    (+1 or -1). pens holds a pen for each pixel, or is null to plot pen
+    throughout. Same result as calling do_plot for each pixel, but the
+    destination layers and clipping are worked out once for the whole run.
+*/
+void ddenlovr_state::plot_span( int x, int y, int xinc, int count, int pen, const uint8_t *pens )
+{
+	uint8_t *layers[8];
+	int nlayers = 0;
+	for (int l = 0; l < (m_extra_layers ? 8 : 4); l++)
+		if (m_ddenlovr_dest_layer & ((l < 4) ? (0x0001 << l) : (0x0100 << (l - 4))))
+			layers[nlayers++] = m_ddenlovr_pixmap[l].get();
+
+	if (!nlayers || count <= 0)
+		return;
+
+	// a single pen covers every column after one lap
+	if (!pens)
+		count = std::min(count, 0x200);
+
+	// the run moves along x in the pixmap, or along y when x & y are swapped
+	const int fixed = y & 0x1ff;
+	int run_lo[2], run_hi[2], runs;
+	int base, stride;
+	if (!(m_ddenlovr_blit_flip & 0x10))
+	{
+		if (!ddenlovr_clip_accepts(fixed, m_ddenlovr_clip_y, m_ddenlovr_clip_height, m_ddenlovr_clip_ctrl >> 2))
+			return;
+		runs = ddenlovr_clip_runs(m_ddenlovr_clip_x, m_ddenlovr_clip_width, m_ddenlovr_clip_ctrl, run_lo, run_hi);
+		base = 512 * fixed;
+		stride = 1;
+	}
+	else
+	{
+		if (!ddenlovr_clip_accepts(fixed, m_ddenlovr_clip_x, m_ddenlovr_clip_width, m_ddenlovr_clip_ctrl))
+			return;
+		runs = ddenlovr_clip_runs(m_ddenlovr_clip_y, m_ddenlovr_clip_height, m_ddenlovr_clip_ctrl >> 2, run_lo, run_hi);
+		base = fixed;
+		stride = 512;
+	}
+
+	// split the run where it wraps around, keeping the order so later pixels win
+	int v = x & 0x1ff;
+	for (int done = 0; done < count; )
+	{
+		const int len = std::min(count - done, (xinc > 0) ? 0x200 - v : v + 1);
+		const int a = (xinc > 0) ? v : v - len + 1;
+		const int b = a + len - 1;
+
+		for (int r = 0; r < runs; r++)
+		{
+			const int lo = std::max(a, run_lo[r]);
+			const int hi = std::min(b, run_hi[r]);
+			if (lo > hi)
+				continue;
+
+			for (int l = 0; l < nlayers; l++)
+			{
+				uint8_t *const dst = layers[l] + base;
+				if (!pens && stride == 1)
+					memset(dst + lo, pen, hi - lo + 1);
+				else if (!pens)
+					for (int i = lo; i <= hi; i++)
+						dst[i * stride] = pen;
+				else if (stride == 1 && xinc > 0)
+					memcpy(dst + lo, pens + done + (lo - v), hi - lo + 1);
+				else
+					for (int i = lo; i <= hi; i++)
+						dst[i * stride] = pens[done + (i - v) * xinc];
+			}
+		}
+
+		done += len;
+		v = (xinc > 0) ? 0 : 0x1ff;
+	}
+}
+
 
 static inline int fetch_bit( uint8_t *src_data, int src_len, int *bit_addr )
 {
@@ -941,27 +1062,32 @@ int ddenlovr_state::blit_draw( int src, int sx )
 						pen = (m_ddenlovr_blit_pen & 0x0f);
 					pen |= m_ddenlovr_blit_pen & 0xf0;
 
-					while (length-- >= 0)
-					{
-						do_plot(x, m_ddenlovr_blit_y, pen);
-						x += xinc;
-					}
+					plot_span(x, m_ddenlovr_blit_y, xinc, length + 1, pen, nullptr);
+					x += xinc * (length + 1);
 				}
 				break;
 
 			case BLIT_COPY:
 				{
 					int length = fetch_word(src_data, src_len, &bit_addr, arg_size);
+					uint8_t pens[0x200];
 
-					while (length-- >= 0)
+					// decode a chunk of pens, then plot it as one span
+					while (length >= 0)
 					{
-						int pen = fetch_word(src_data, src_len, &bit_addr, pen_size);
-						if (m_ddenlovr_blit_pen_mode)
-							pen = (m_ddenlovr_blit_pen & 0x0f);
-						pen |= m_ddenlovr_blit_pen & 0xf0;
-
-						do_plot(x, m_ddenlovr_blit_y, pen);
-						x += xinc;
+						const int chunk = std::min(length + 1, 0x200);
+						for (int i = 0; i < chunk; i++)
+						{
+							int pen = fetch_word(src_data, src_len, &bit_addr, pen_size);
+							if (m_ddenlovr_blit_pen_mode)
+								pen = (m_ddenlovr_blit_pen & 0x0f);
+							pen |= m_ddenlovr_blit_pen & 0xf0;
+							pens[i] = pen;
+						}
+
+						plot_span(x, m_ddenlovr_blit_y, xinc, chunk, 0, pens);
+						x += xinc * chunk;
+						length -= chunk;
 					}
 				}
 				break;
@@ -993,16 +1119,13 @@ int ddenlovr_state::blit_draw( int src, int sx )
 */
 void ddenlovr_state::blit_rect_xywh()
 {
-	int x, y;
-
 #ifdef MAME_DEBUG
 //  if (m_ddenlovr_clip_ctrl != 0x0f)
 //      popmessage("RECT clipx=%03x clipy=%03x ctrl=%x", m_ddenlovr_clip_x, m_ddenlovr_clip_y, m_ddenlovr_clip_ctrl);
 #endif
 
-	for (y = 0; y <= m_ddenlovr_rect_height; y++)
-		for (x = 0; x <= m_ddenlovr_rect_width; x++)
-			do_plot(x + m_ddenlovr_blit_x, y + m_ddenlovr_blit_y, m_ddenlovr_blit_pen);
+	for (int y = 0; y <= m_ddenlovr_rect_height; y++)
+		plot_span(m_ddenlovr_blit_x, y + m_ddenlovr_blit_y, 1, m_ddenlovr_rect_width + 1, m_ddenlovr_blit_pen, nullptr);
 }
 
 
@@ -1092,8 +1215,6 @@ void ddenlovr_state::blit_fill_xy( int x, int y )
 */
 void ddenlovr_state::blit_horiz_line()
 {
-	int i;
-
 #ifdef MAME_DEBUG
 	popmessage("LINE X");
 
@@ -1104,8 +1225,9 @@ void ddenlovr_state::blit_horiz_line()
 		popmessage("LINE X flip=%x", m_ddenlovr_blit_flip);
 #endif
 
-	for (i = 0; i <= m_ddenlovr_line_length; i++)
-		do_plot(m_ddenlovr_blit_x++, m_ddenlovr_blit_y, m_ddenlovr_blit_pen);
+	const int length = std::max(m_ddenlovr_line_length + 1, 0);
+	plot_span(m_ddenlovr_blit_x, m_ddenlovr_blit_y, 1, length, m_ddenlovr_blit_pen, nullptr);
+	m_ddenlovr_blit_x += length;
 }
 
 
@@ -1701,36 +1823,105 @@ uint8_t ddenlovr_state::ddenlovr_gfxrom_r()
 }
 
 
-void ddenlovr_state::copylayer(bitmap_rgb32 &bitmap, const rectangle &cliprect, int layer)
+/*  Let the opaque pixels of one layer line replace the entries in a line of
+    (layer << 8 | pen) indexes, sixteen at a time with SSE2.
+*/
+static void ddenlovr_select_layer(uint16_t *index, const uint8_t *src, int count, uint8_t transmask, uint8_t transpen, uint16_t layer)
+{
+	int x = 0;
+#if defined(DDENLOVR_COMPOSE_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i mask = _mm_set1_epi8(char(transmask));
+	const __m128i trans = _mm_set1_epi8(char(transpen));
+	const __m128i hi = _mm_set1_epi16(short(layer));
+	for ( ; x + 16 <= count; x += 16)
+	{
+		const __m128i pix = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[x]));
+		const __m128i keep = _mm_cmpeq_epi8(_mm_and_si128(pix, mask), trans);
+		const __m128i keep_lo = _mm_unpacklo_epi8(keep, keep);
+		const __m128i keep_hi = _mm_unpackhi_epi8(keep, keep);
+		const __m128i old_lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&index[x]));
+		const __m128i old_hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&index[x + 8]));
+		const __m128i new_lo = _mm_or_si128(_mm_unpacklo_epi8(pix, zero), hi);
+		const __m128i new_hi = _mm_or_si128(_mm_unpackhi_epi8(pix, zero), hi);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&index[x]), _mm_or_si128(_mm_and_si128(keep_lo, old_lo), _mm_andnot_si128(keep_lo, new_lo)));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&index[x + 8]), _mm_or_si128(_mm_and_si128(keep_hi, old_hi), _mm_andnot_si128(keep_hi, new_hi)));
+	}
+#endif
+	for ( ; x < count; x++)
+		if ((src[x] & transmask) != transpen)
+			index[x] = layer | src[x];
+}
+
+/*  Draw the enabled layers in the given order over the background colour.
+    Every line is first resolved to a layer and pen per pixel, so only the
+    pixel that ends up on top is looked up in the palette.
+*/
+void ddenlovr_state::copylayers(bitmap_rgb32 &bitmap, const rectangle &cliprect, const int *layers, int count)
 {
-	int scrollx = m_ddenlovr_scroll[layer / 4 * 8 + (layer % 4) + 0];
-	int scrolly = m_ddenlovr_scroll[layer / 4 * 8 + (layer % 4) + 4];
+	const int width = cliprect.width();
+	const uint16_t background = 8 << 8;
 
-	int palbase = m_ddenlovr_palette_base[layer];
-	int penmask = m_ddenlovr_palette_mask[layer];
+	pen_t lut[(8 << 8) + 1];
+	lut[background] = m_palette->pen(m_ddenlovr_bgcolor);
 
-	int transpen = m_ddenlovr_transparency_pen[layer];
-	int transmask = m_ddenlovr_transparency_mask[layer];
+	int enabled[8];
+	int nenabled = 0;
+	for (int i = 0; i < count; i++)
+	{
+		const int layer = layers[i];
+		if (!(((m_ddenlovr_layer_enable2 << 4) | m_ddenlovr_layer_enable) & (1 << layer)))
+			continue;
 
-	palbase  &= ~penmask;
-	transpen &= transmask;
+		enabled[nenabled++] = layer;
 
-	const pen_t *pens = &m_palette->pen(palbase);
+		const int penmask = m_ddenlovr_palette_mask[layer];
+		const pen_t *pens = &m_palette->pen(m_ddenlovr_palette_base[layer] & ~penmask);
+		for (int pen = 0; pen < 0x100; pen++)
+			lut[(layer << 8) | pen] = pens[pen & penmask];
+	}
 
-	if (((m_ddenlovr_layer_enable2 << 4) | m_ddenlovr_layer_enable) & (1 << layer))
+	std::vector<uint16_t> index(width);
+	std::vector<uint8_t> src(width);
+
+	for (int y = cliprect.top(); y <= cliprect.bottom(); y++)
 	{
-		for (int y = cliprect.top(); y <= cliprect.bottom(); y++)
+		std::fill(index.begin(), index.end(), background);
+
+		for (int i = 0; i < nenabled; i++)
 		{
-			for (int x = cliprect.left(); x <= cliprect.right(); x++)
+			const int layer = enabled[i];
+			const int scrollx = m_ddenlovr_scroll[layer / 4 * 8 + (layer % 4) + 0];
+			const int scrolly = m_ddenlovr_scroll[layer / 4 * 8 + (layer % 4) + 4];
+
+			int transpen = m_ddenlovr_transparency_pen[layer];
+			int transmask = m_ddenlovr_transparency_mask[layer];
+			transpen &= transmask;
+
+			// a pen outside 8 bits can never match, so every pixel is opaque
+			if (transpen & ~0xff)
 			{
-				int pen = m_ddenlovr_pixmap[layer][512 * ((y + scrolly) & 0x1ff) + ((x + scrollx) & 0x1ff)];
-				if ((pen & transmask) != transpen)
-				{
-					pen &= penmask;
-					bitmap.pix(y, x) = pens[pen];
-				}
+				transmask = 0;
+				transpen = 1;
 			}
+
+			// fetch the scrolled line, wrapping around at 512 pixels
+			const uint8_t *const line = &m_ddenlovr_pixmap[layer][512 * ((y + scrolly) & 0x1ff)];
+			int sx = (cliprect.left() + scrollx) & 0x1ff;
+			for (int x = 0; x < width; )
+			{
+				const int len = std::min(width - x, 0x200 - sx);
+				memcpy(&src[x], &line[sx], len);
+				x += len;
+				sx = 0;
+			}
+
+			ddenlovr_select_layer(&index[0], &src[0], width, transmask, transpen, layer << 8);
 		}
+
+		uint32_t *const dst = &bitmap.pix(y, cliprect.left());
+		for (int x = 0; x < width; x++)
+			dst[x] = lut[index[x]];
 	}
 }
 
@@ -1772,8 +1963,6 @@ uint32_t ddenlovr_state::screen_update_ddenlovr(screen_device &screen, bitmap_rg
 	if (machine().input().code_pressed_once(KEYCODE_F)) { base++; while ((gfx[base] & 0xf0) != 0x30) base++; }
 #endif
 
-	bitmap.fill(m_palette->pen(m_ddenlovr_bgcolor), cliprect);
-
 #ifdef MAME_DEBUG
 	if (machine().input().code_pressed(KEYCODE_Z))
 	{
@@ -1812,10 +2001,11 @@ uint32_t ddenlovr_state::screen_update_ddenlovr(screen_device &screen, bitmap_rg
 		pri = 0;
 	}
 
-	copylayer(bitmap, cliprect, order[pri][0]);
-	copylayer(bitmap, cliprect, order[pri][1]);
-	copylayer(bitmap, cliprect, order[pri][2]);
-	copylayer(bitmap, cliprect, order[pri][3]);
+	int layers[8];
+	int count = 0;
+
+	for (int i = 0; i < 4; i++)
+		layers[count++] = order[pri][i];
 
 	if (m_extra_layers)
 	{
@@ -1827,12 +2017,12 @@ uint32_t ddenlovr_state::screen_update_ddenlovr(screen_device &screen, bitmap_rg
 			pri = 0;
 		}
 
-		copylayer(bitmap, cliprect, order[pri][0] + 4);
-		copylayer(bitmap, cliprect, order[pri][1] + 4);
-		copylayer(bitmap, cliprect, order[pri][2] + 4);
-		copylayer(bitmap, cliprect, order[pri][3] + 4);
+		for (int i = 0; i < 4; i++)
+			layers[count++] = order[pri][i] + 4;
 	}
 
+	copylayers(bitmap, cliprect, layers, count);
+
 	m_ddenlovr_layer_enable = enab;
 	m_ddenlovr_layer_enable2 = enab2;
 
@@ -75,6 +75,11 @@ Notes:
 #include "screen.h"
 #include "speaker.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IGS011_COMPOSE_SSE2 1
+#endif
+
 
 namespace {
 
@@ -348,6 +353,61 @@ void igs011_state::video_start()
 	save_item(NAME(m_blitter.flags));
 }
 
+/*
+    Compose one line. For each pixel a byte with a bit set for every
+    transparent layer is built (sixteen pixels at a time with SSE2), and
+    the top layer comes from a 256 entry table made from the selected
+    priority RAM. Runs of sixteen pixels that all resolve to the same
+    layer, the usual case, are copied from that layer in one go.
+*/
+
+static void igs011_compose_line(u16 *dest, const u8 *const *layer, const u8 *top, int count)
+{
+	int x = 0;
+#if defined(IGS011_COMPOSE_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i trans = _mm_set1_epi8(char(0xff));
+	for ( ; x + 16 <= count; x += 16)
+	{
+		__m128i mask = zero;
+		for (int l = 0; l < 8; l++)
+		{
+			const __m128i pix = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&layer[l][x]));
+			mask = _mm_or_si128(mask, _mm_and_si128(_mm_cmpeq_epi8(pix, trans), _mm_set1_epi8(char(1 << l))));
+		}
+
+		alignas(16) u8 pri_addr[16];
+		_mm_store_si128(reinterpret_cast<__m128i *>(pri_addr), mask);
+
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(mask, _mm_set1_epi8(char(pri_addr[0])))) == 0xffff)
+		{
+			const int l = top[pri_addr[0]];
+			const __m128i pix = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&layer[l][x]));
+			const __m128i hi = _mm_set1_epi16(s16(l << 8));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[x]), _mm_or_si128(_mm_unpacklo_epi8(pix, zero), hi));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[x + 8]), _mm_or_si128(_mm_unpackhi_epi8(pix, zero), hi));
+		}
+		else
+		{
+			for (int i = 0; i < 16; i++)
+			{
+				const int l = top[pri_addr[i]];
+				dest[x + i] = layer[l][x + i] | (l << 8);
+			}
+		}
+	}
+#endif
+	for ( ; x < count; x++)
+	{
+		int pri_addr = 0;
+		for (int l = 0; l < 8; l++)
+			pri_addr |= (layer[l][x] == 0xff) << l;
+
+		const int l = top[pri_addr];
+		dest[x] = layer[l][x] | (l << 8);
+	}
+}
+
 u32 igs011_state::screen_update(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect)
 {
 #ifdef MAME_DEBUG
@@ -372,34 +432,43 @@ u32 igs011_state::screen_update(screen_device &screen, bitmap_ind16 &bitmap, con
 
 	u16 *pri_ram = &m_priority_ram[(m_priority & 7) * 512/2];
 
-	for (int y = cliprect.min_y; y <= cliprect.max_y; y++)
+#ifdef MAME_DEBUG
+	if (layer_enable != -1)
 	{
-		for (int x = cliprect.min_x; x <= cliprect.max_x; x++)
+		for (int y = cliprect.min_y; y <= cliprect.max_y; y++)
 		{
-			int scr_addr = x + y * 512;
-			int pri_addr = 0xff;
-
-			int l;
-			for (l = 0; l < 8; l++)
+			for (int x = cliprect.min_x; x <= cliprect.max_x; x++)
 			{
-				if (  (m_layer[l][scr_addr] != 0xff)
-#ifdef MAME_DEBUG
-						&& (layer_enable & (1 << l))
-#endif
-					)
-					pri_addr &= ~(1 << l);
-			}
+				int scr_addr = x + y * 512;
+				int pri_addr = 0xff;
 
+				for (int l = 0; l < 8; l++)
+					if ((m_layer[l][scr_addr] != 0xff) && (layer_enable & (1 << l)))
+						pri_addr &= ~(1 << l);
 
-			l   =   pri_ram[pri_addr] & 7;
+				int l = pri_ram[pri_addr] & 7;
 
-#ifdef MAME_DEBUG
-			if ((layer_enable != -1) && (pri_addr == 0xff))
-				bitmap.pix(y, x) = m_palette->black_pen();
-			else
-#endif
-				bitmap.pix(y, x) = m_layer[l][scr_addr] | (l << 8);
+				if (pri_addr == 0xff)
+					bitmap.pix(y, x) = m_palette->black_pen();
+				else
+					bitmap.pix(y, x) = m_layer[l][scr_addr] | (l << 8);
+			}
 		}
+		return 0;
+	}
+#endif
+
+	u8 top[0x100];
+	for (int i = 0; i < 0x100; i++)
+		top[i] = pri_ram[i] & 7;
+
+	for (int y = cliprect.min_y; y <= cliprect.max_y; y++)
+	{
+		const u8 *layer[8];
+		for (int l = 0; l < 8; l++)
+			layer[l] = &m_layer[l][cliprect.min_x + y * 512];
+
+		igs011_compose_line(&bitmap.pix(y, cliprect.min_x), layer, top, cliprect.width());
 	}
 	return 0;
 }
@@ -154,6 +154,7 @@ public:
 protected:
 	virtual void machine_start() override;
 	virtual void machine_reset() override;
+	virtual void device_post_load() override;
 
 private:
 	// for Print Club only
@@ -174,6 +175,12 @@ private:
 	uint8_t       m_palbank;
 	uint8_t       m_bg_palbase;
 	uint8_t       m_sp_palbase;
+	bool          m_palette_tables_dirty;     /* lookup tables need recomputing */
+	uint32_t      m_palette_dirty[0x800 / 32];/* colour RAM entries written since the last flush */
+	int           m_palette_dirty_min;        /* lowest dirty word index, or 0x800 if none */
+	int           m_palette_dirty_max;        /* highest dirty word index */
+	uint32_t      m_palette_converted;        /* pens recomputed this frame, for LOG_PALETTE */
+	uint64_t      m_palette_frame;            /* frame the count above belongs to */
 
 	/* sound-related variables */
 	uint8_t       m_sound_banks;      /* number of sound banks */
@@ -185,6 +192,7 @@ private:
 	int m_segac2_bg_pal_lookup[4];
 	int m_segac2_sp_pal_lookup[4];
 	void recompute_palette_tables();
+	void flush_palette();
 
 	DECLARE_WRITE_LINE_MEMBER(vdp_sndirqline_callback_c2);
 	DECLARE_WRITE_LINE_MEMBER(vdp_lv6irqline_callback_c2);
@@ -259,10 +267,29 @@ void segac2_state::machine_start()
 	save_item(NAME(m_prot_write_buf));
 	save_item(NAME(m_prot_read_buf));
 
+	std::fill(std::begin(m_palette_dirty), std::end(m_palette_dirty), 0);
+	m_palette_tables_dirty = true;
+	m_palette_dirty_min = 0x800;
+	m_palette_dirty_max = 0;
+	m_palette_converted = 0;
+	m_palette_frame = 0;
+
 	m_vdp->stop_timers();
 }
 
 
+void segac2_state::device_post_load()
+{
+	md_base_state::device_post_load();
+
+	/* the pens are derived from colour RAM, so rebuild them all */
+	std::fill(std::begin(m_palette_dirty), std::end(m_palette_dirty), ~uint32_t(0));
+	m_palette_dirty_min = 0;
+	m_palette_dirty_max = 0x7ff;
+	m_palette_tables_dirty = true;
+}
+
+
 void segac2_state::machine_reset()
 {
 //  megadriv_scanline_timer = machine().device<timer_device>("md_scan_timer");
@@ -296,6 +323,7 @@ void segac2_state::machine_reset()
 	m_sp_palbase = 0;
 
 	recompute_palette_tables();
+	m_palette_tables_dirty = false;
 }
 
 
@@ -359,37 +387,82 @@ uint16_t segac2_state::palette_r(offs_t offset)
 /* handle writes to the paletteram */
 void segac2_state::palette_w(offs_t offset, uint16_t data, uint16_t mem_mask)
 {
-	int r, g, b, newword;
-	int tmpr, tmpg, tmpb;
-
 	/* adjust for the palette bank */
 	offset &= 0x1ff;
 	if (m_segac2_alt_palette_mode)
 		offset = ((offset << 1) & 0x100) | ((offset << 2) & 0x80) | ((~offset >> 2) & 0x40) | ((offset >> 1) & 0x20) | (offset & 0x1f);
 	offset += m_palbank * 0x200;
 
-	/* combine data */
+	/* combine data; the pens are recomputed in one go before the next line is drawn */
 	COMBINE_DATA(&m_paletteram[offset]);
-	newword = m_paletteram[offset];
+	m_palette_dirty[offset / 32] |= 1U << (offset % 32);
+	m_palette_dirty_min = std::min<int>(m_palette_dirty_min, offset);
+	m_palette_dirty_max = std::max<int>(m_palette_dirty_max, offset);
+}
 
-	/* up to 8 bits */
-	r = ((newword << 1) & 0x1e) | ((newword >> 12) & 0x01);
-	g = ((newword >> 3) & 0x1e) | ((newword >> 13) & 0x01);
-	b = ((newword >> 7) & 0x1e) | ((newword >> 14) & 0x01);
 
-	/* set the color */
-	m_palette->set_pen_color(offset, pal5bit(r), pal5bit(g), pal5bit(b));
+/* convert every colour RAM entry written since the last call into its normal, shadow and highlight pens */
+void segac2_state::flush_palette()
+{
+	/* each 5-bit gun as itself, halved for shadow, and halved plus half scale for highlight */
+	static const struct palette_levels
+	{
+		uint8_t level[3][32];
 
-	tmpr = r >> 1;
-	tmpg = g >> 1;
-	tmpb = b >> 1;
-	m_palette->set_pen_color(offset + 0x800, pal5bit(tmpr), pal5bit(tmpg), pal5bit(tmpb));
+		constexpr palette_levels() : level()
+		{
+			for (int i = 0; i < 32; i++)
+			{
+				level[0][i] = pal5bit(i);
+				level[1][i] = pal5bit(i >> 1);
+				level[2][i] = pal5bit((i >> 1) | 0x10);
+			}
+		}
+	} s_levels;
 
-	// how is it calculated on c2?
-	tmpr = tmpr | 0x10;
-	tmpg = tmpg | 0x10;
-	tmpb = tmpb | 0x10;
-	m_palette->set_pen_color(offset + 0x1000, pal5bit(tmpr), pal5bit(tmpg), pal5bit(tmpb));
+	if (m_palette_tables_dirty)
+	{
+		m_palette_tables_dirty = false;
+		recompute_palette_tables();
+	}
+
+	/* report the previous frame's count once a new frame starts */
+	if (m_screen && m_screen->frame_number() != m_palette_frame)
+	{
+		if (LOG_PALETTE && m_palette_converted) logerror("Frame %d: %d colour RAM entries converted\n", m_palette_frame, m_palette_converted);
+		m_palette_frame = m_screen->frame_number();
+		m_palette_converted = 0;
+	}
+
+	if (m_palette_dirty_min <= m_palette_dirty_max)
+	{
+		for (int word = m_palette_dirty_min / 32; word <= m_palette_dirty_max / 32; word++)
+		{
+			uint32_t bits = m_palette_dirty[word];
+			for (int bit = 0; bits; bit++, bits >>= 1)
+			{
+				if (!(bits & 1))
+					continue;
+
+				const int offset = word * 32 + bit;
+				const uint16_t newword = m_paletteram[offset];
+
+				/* up to 8 bits */
+				const int r = ((newword << 1) & 0x1e) | ((newword >> 12) & 0x01);
+				const int g = ((newword >> 3) & 0x1e) | ((newword >> 13) & 0x01);
+				const int b = ((newword >> 7) & 0x1e) | ((newword >> 14) & 0x01);
+
+				// how the shadow and highlight levels are calculated on c2 isn't known
+				m_palette->set_pen_color(offset,          rgb_t(s_levels.level[0][r], s_levels.level[0][g], s_levels.level[0][b]));
+				m_palette->set_pen_color(offset + 0x800,  rgb_t(s_levels.level[1][r], s_levels.level[1][g], s_levels.level[1][b]));
+				m_palette->set_pen_color(offset + 0x1000, rgb_t(s_levels.level[2][r], s_levels.level[2][g], s_levels.level[2][b]));
+				m_palette_converted++;
+			}
+			m_palette_dirty[word] = 0;
+		}
+		m_palette_dirty_min = 0x800;
+		m_palette_dirty_max = 0;
+	}
 }
 
 
@@ -493,7 +566,7 @@ void segac2_state::io_porth_w(uint8_t data)
 	{
 		//m_screen->update_partial(m_screen->vpos() + 1);
 		m_palbank = newbank;
-		recompute_palette_tables();
+		m_palette_tables_dirty = true;
 	}
 	if (m_sound_banks > 1)
 	{
@@ -527,7 +600,7 @@ void segac2_state::control_w(uint8_t data)
 
 	/* bit 2 controls palette shuffling; only ribbit and twinsqua use this feature */
 	m_segac2_alt_palette_mode = ((~data & 4) >> 2);
-	recompute_palette_tables();
+	m_palette_tables_dirty = true;
 }
 
 
@@ -575,7 +648,7 @@ void segac2_state::prot_w(uint8_t data)
 		//m_screen->update_partial(m_screen->vpos() + 1);
 		m_sp_palbase = new_sp_palbase;
 		m_bg_palbase = new_bg_palbase;
-		recompute_palette_tables();
+		m_palette_tables_dirty = true;
 		if (LOG_PALETTE && m_screen) logerror("Set palbank: %d/%d (scan=%d)\n", m_bg_palbase, m_sp_palbase, m_screen->vpos());
 	}
 }
@@ -1607,6 +1680,8 @@ WRITE_LINE_MEMBER(segac2_state::segac2_irq2_interrupt)
 //  and applies it's own external colour circuity
 uint32_t segac2_state::screen_update_segac2_new(screen_device &screen, bitmap_rgb32 &bitmap, const rectangle &cliprect)
 {
+	flush_palette();
+
 	const pen_t *paldata = m_palette->pens();
 	if (!m_segac2_enable_display)
 	{
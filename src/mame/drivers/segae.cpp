@@ -313,6 +313,13 @@ GND  8A 8B GND
 #include "video/315_5124.h"
 #include "speaker.h"
 
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SYSTEME_MERGE_SSE2 1
+#endif
+
 
 class systeme_state : public driver_device
 {
@@ -872,24 +879,61 @@ static INPUT_PORTS_START( megrescu )
 	PORT_DIPSETTING(   0x10, DEF_STR( Cocktail ) )
 INPUT_PORTS_END
 
+/*
+    The board output picks VDP2 wherever its Y1 line is asserted (a non
+    transparent pixel or a non-zero backdrop) and VDP1 everywhere else.
+    Whole lines are usually one or the other, so those are copied outright;
+    mixed lines go through a branchless select.
+*/
+
+static void systeme_merge_span(uint32_t *dest, uint32_t const *vdp1, uint32_t const *vdp2, uint8_t const *y1, int count)
+{
+	int x = 0;
+#if defined(SYSTEME_MERGE_SSE2)
+	__m128i const zero = _mm_setzero_si128();
+	for ( ; x + 4 <= count; x += 4)
+	{
+		int32_t sel;
+		memcpy(&sel, &y1[x], sizeof(sel));
+		__m128i const wide = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(sel), zero), zero);
+		__m128i const use_vdp1 = _mm_cmpeq_epi32(wide, zero);
+		__m128i const a = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&vdp1[x]));
+		__m128i const b = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&vdp2[x]));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[x]), _mm_or_si128(_mm_and_si128(use_vdp1, a), _mm_andnot_si128(use_vdp1, b)));
+	}
+#endif
+	for ( ; x < count; x++)
+	{
+		uint32_t const use_vdp2 = -uint32_t(y1[x] != 0);
+		dest[x] = (vdp2[x] & use_vdp2) | (vdp1[x] & ~use_vdp2);
+	}
+}
+
 uint32_t systeme_state::screen_update(screen_device &screen, bitmap_rgb32 &bitmap, const rectangle &cliprect)
 {
 	bitmap_rgb32 const &vdp1_bitmap = m_vdp1->get_bitmap();
 	bitmap_rgb32 const &vdp2_bitmap = m_vdp2->get_bitmap();
 	bitmap_ind8 const &vdp2_y1 = m_vdp2->get_y1_bitmap();
+	int const width = cliprect.width();
 
 	for( int y = cliprect.min_y; y <= cliprect.max_y; y++ )
 	{
-		uint32_t *const dest_ptr = &bitmap.pix(y);
-		uint32_t const *const vdp1_ptr = &vdp1_bitmap.pix(y);
-		uint32_t const *const vdp2_ptr = &vdp2_bitmap.pix(y);
-		uint8_t const *const y1_ptr = &vdp2_y1.pix(y);
-
-		for ( int x = cliprect.min_x; x <= cliprect.max_x; x++ )
-		{
-			dest_ptr[x] = ( y1_ptr[x] ) ? vdp2_ptr[x] : vdp1_ptr[x];
-			//dest_ptr[x] = y1_ptr[x] ? 0x00FF00 : 0xFF0000;
-		}
+		uint32_t *const dest_ptr = &bitmap.pix(y, cliprect.min_x);
+		uint32_t const *const vdp1_ptr = &vdp1_bitmap.pix(y, cliprect.min_x);
+		uint32_t const *const vdp2_ptr = &vdp2_bitmap.pix(y, cliprect.min_x);
+		uint8_t const *const y1_ptr = &vdp2_y1.pix(y, cliprect.min_x);
+
+		// count the selected pixels; this is a plain byte reduction, far cheaper than the merge
+		int selected = 0;
+		for ( int x = 0; x < width; x++ )
+			selected += y1_ptr[x] != 0;
+
+		if (selected == 0)
+			memcpy(dest_ptr, vdp1_ptr, width * sizeof(uint32_t));
+		else if (selected == width)
+			memcpy(dest_ptr, vdp2_ptr, width * sizeof(uint32_t));
+		else
+			systeme_merge_span(dest_ptr, vdp1_ptr, vdp2_ptr, y1_ptr, width);
 	}
 
 	return 0;
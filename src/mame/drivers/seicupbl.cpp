@@ -93,8 +93,20 @@ private:
 
 	virtual void video_start() override;
 
+	// one 16x16 tile of a sprite, with flip and priority already worked out
+	struct sprite_tile
+	{
+		uint32_t code;
+		uint32_t color;
+		int flipx, flipy;
+		int x, y;
+		uint32_t pri_mask;
+	};
+
+	void build_sprite_tiles(const rectangle &cliprect);
 	void draw_sprites(screen_device &screen, bitmap_ind16 &bitmap,const rectangle &cliprect);
 	uint16_t m_layer_disable;
+	std::vector<sprite_tile> m_sprite_tiles;
 };
 
 TILE_GET_INFO_MEMBER(seicupbl_state::get_sc0_tileinfo)
@@ -141,13 +153,17 @@ TILE_GET_INFO_MEMBER(seicupbl_state::get_sc3_tileinfo)
 	tileinfo.set(0,tile,color,0);
 }
 
-void seicupbl_state::draw_sprites(screen_device &screen, bitmap_ind16 &bitmap,const rectangle &cliprect)
+/* Turn the sprite list into a flat list of tiles in drawing order. Sprites
+   and tiles that lie completely outside the clip rectangle are left out. */
+void seicupbl_state::build_sprite_tiles(const rectangle &cliprect)
 {
 	uint16_t *spriteram16 = m_spriteram;
 	int offs,fx,fy,x,y,color,sprite,cur_pri;
 	int dx,dy,ax,ay;
 	int pri_mask;
 
+	m_sprite_tiles.clear();
+
 	for (offs = 0;offs < 0x400;offs += 4)
 	{
 		uint16_t data = spriteram16[offs];
@@ -222,59 +238,38 @@ void seicupbl_state::draw_sprites(screen_device &screen, bitmap_ind16 &bitmap,co
 		dy = ((data &0x0380) >> 7)  + 1;
 		dx = ((data &0x1c00) >> 10) + 1;
 
-		if (!fx)
-		{
-			if(!fy)
-			{
-				for (ax=0; ax<dx; ax++)
-					for (ay=0; ay<dy; ay++)
-					{
-						m_gfxdecode->gfx(3)->prio_transpen(bitmap,cliprect,
-						sprite++,
-						color,fx,fy,(x+ax*16),y+ay*16,
-						screen.priority(),pri_mask, 15);
-					}
-			}
-			else
-			{
-				for (ax=0; ax<dx; ax++)
-					for (ay=0; ay<dy; ay++)
-					{
-						m_gfxdecode->gfx(3)->prio_transpen(bitmap,cliprect,
-						sprite++,
-						color,fx,fy,(x+ax*16),y+(dy-ay-1)*16,
-						screen.priority(),pri_mask,15);
-					}
-			}
-		}
-		else
+		if (x > cliprect.max_x || x + dx*16 <= cliprect.min_x || y > cliprect.max_y || y + dy*16 <= cliprect.min_y)
+			continue;
+
+		// tiles run down each column first; flipping mirrors their placement
+		for (ax=0; ax<dx; ax++)
 		{
-			if(!fy)
-			{
-				for (ax=0; ax<dx; ax++)
-					for (ay=0; ay<dy; ay++)
-					{
-						m_gfxdecode->gfx(3)->prio_transpen(bitmap,cliprect,
-						sprite++,
-						color,fx,fy,(x+(dx-ax-1)*16)+0,y+ay*16,
-						screen.priority(),pri_mask,15);
-					}
-			}
-			else
+			const int tx = x + (fx ? (dx-ax-1) : ax)*16;
+			for (ay=0; ay<dy; ay++, sprite++)
 			{
-				for (ax=0; ax<dx; ax++)
-					for (ay=0; ay<dy; ay++)
-					{
-						m_gfxdecode->gfx(3)->prio_transpen(bitmap,cliprect,
-						sprite++,
-						color,fx,fy,(x+(dx-ax-1)*16)+0,y+(dy-ay-1)*16,
-						screen.priority(),pri_mask, 15);
-					}
+				const int ty = y + (fy ? (dy-ay-1) : ay)*16;
+				if (tx > cliprect.max_x || tx + 16 <= cliprect.min_x || ty > cliprect.max_y || ty + 16 <= cliprect.min_y)
+					continue;
+
+				m_sprite_tiles.push_back(sprite_tile{ uint32_t(sprite), uint32_t(color), fx, fy, tx, ty, uint32_t(pri_mask) });
 			}
 		}
 	}
 }
 
+void seicupbl_state::draw_sprites(screen_device &screen, bitmap_ind16 &bitmap,const rectangle &cliprect)
+{
+	gfx_element *gfx = m_gfxdecode->gfx(3);
+
+	build_sprite_tiles(cliprect);
+
+	for (const sprite_tile &tile : m_sprite_tiles)
+		gfx->prio_transpen(bitmap,cliprect,
+				tile.code,
+				tile.color,tile.flipx,tile.flipy,tile.x,tile.y,
+				screen.priority(),tile.pri_mask,15);
+}
+
 
 void seicupbl_state::video_start()
 {
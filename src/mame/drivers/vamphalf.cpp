@@ -185,6 +185,7 @@ private:
 	// driver init configuration
 	bool m_has_extra_gfx;
 	bool m_flipscreen;
+	int m_visarea_flip;     // flip state the visible area was last set up for, -1 if none
 
 	void jmpbreak_flipscreen_w(u16 data);
 	void boonggab_prize_w(offs_t offset, u16 data);
@@ -741,11 +742,14 @@ void vamphalf_state::video_start()
 	save_item(NAME(m_flipscreen));
 
 	m_flipscreen = 0;
+	m_visarea_flip = -1;
 }
 
 void vamphalf_state::draw_sprites(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect)
 {
 	gfx_element *gfx = m_gfxdecode->gfx(0);
+	const int width = gfx->width();
+	const int height = gfx->height();
 	rectangle clip = cliprect;
 	int block;
 
@@ -774,6 +778,19 @@ void vamphalf_state::draw_sprites(screen_device &screen, bitmap_ind16 &bitmap, c
 
 			if (m_tiles[offs] & 0x0100) continue;
 
+			int x = m_tiles[offs+3] & 0x01ff;
+			int y = 256 - (m_tiles[offs] & 0x00ff);
+
+			if (m_flipscreen)
+			{
+				x = 366 - x;
+				y = 256 - y;
+			}
+
+			// most of each block lies outside this band, so drop those before going to the gfx code
+			if (x > clip.max_x || x + width <= clip.min_x || y > clip.max_y || y + height <= clip.min_y)
+				continue;
+
 			u32 code = m_tiles[offs+1];
 			const u32 color = (m_tiles[offs+2] >> m_palshift) & 0x7f;
 
@@ -783,9 +800,6 @@ void vamphalf_state::draw_sprites(screen_device &screen, bitmap_ind16 &bitmap, c
 				code |= ((m_tiles[offs+2] & 0x100) << 8);
 			}
 
-			int x = m_tiles[offs+3] & 0x01ff;
-			int y = 256 - (m_tiles[offs] & 0x00ff);
-
 			int fx = m_tiles[offs] & 0x8000;
 			int fy = m_tiles[offs] & 0x4000;
 
@@ -793,9 +807,6 @@ void vamphalf_state::draw_sprites(screen_device &screen, bitmap_ind16 &bitmap, c
 			{
 				fx = !fx;
 				fy = !fy;
-
-				x = 366 - x;
-				y = 256 - y;
 			}
 
 			gfx->transpen(bitmap,clip,code,color,fx,fy,x,y,0);
@@ -827,6 +838,8 @@ Offset+3
 void vamphalf_state::draw_sprites_aoh(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect)
 {
 	gfx_element *gfx = m_gfxdecode->gfx(0);
+	const int width = gfx->width();
+	const int height = gfx->height();
 	rectangle clip = cliprect;
 	int block;
 
@@ -852,12 +865,22 @@ void vamphalf_state::draw_sprites_aoh(screen_device &screen, bitmap_ind16 &bitma
 		for (u32 cnt = 0; cnt < 0x800; cnt += 8)
 		{
 			const int offs = (block + cnt) / 2;
-			const u32 code  = (m_tiles[offs+1] & 0xffff) | ((m_tiles[offs] & 0x300) << 8);
-			const u32 color = (m_tiles[offs+2] >> m_palshift) & 0x7f;
 
 			int x = m_tiles[offs+3] & 0x01ff;
 			int y = 256 - (m_tiles[offs] & 0x00ff);
 
+			if (m_flipscreen)
+			{
+				x = 366 - x;
+				y = 256 - y;
+			}
+
+			if (x > clip.max_x || x + width <= clip.min_x || y > clip.max_y || y + height <= clip.min_y)
+				continue;
+
+			const u32 code  = (m_tiles[offs+1] & 0xffff) | ((m_tiles[offs] & 0x300) << 8);
+			const u32 color = (m_tiles[offs+2] >> m_palshift) & 0x7f;
+
 			int fx = m_tiles[offs] & 0x400;
 			int fy = 0; // not used ? or it's m_tiles[offs] & 0x800?
 
@@ -865,9 +888,6 @@ void vamphalf_state::draw_sprites_aoh(screen_device &screen, bitmap_ind16 &bitma
 			{
 				fx = !fx;
 				fy = !fy;
-
-				x = 366 - x;
-				y = 256 - y;
 			}
 
 			gfx->transpen(bitmap,clip,code,color,fx,fy,x,y,0);
@@ -878,6 +898,12 @@ void vamphalf_state::draw_sprites_aoh(screen_device &screen, bitmap_ind16 &bitma
 
 void vamphalf_state::handle_flipped_visible_area(screen_device &screen)
 {
+	// reconfiguring the screen is not free, so only do it when the flip state changes
+	if (m_visarea_flip == int(m_flipscreen))
+		return;
+
+	m_visarea_flip = m_flipscreen;
+
 	// are there actually registers to handle this?
 	if (!m_flipscreen)
 	{
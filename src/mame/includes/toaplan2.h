@@ -192,6 +192,7 @@ private:
 	// Teki Paki sound
 	u8 tekipaki_cmdavailable_r();
 
+	void render_dual_vdp(bitmap_ind16 &bitmap, const rectangle &cliprect);
 	u32 screen_update_toaplan2(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect);
 	u32 screen_update_dogyuun(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect);
 	u32 screen_update_batsugun(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect);
@@ -85,6 +85,22 @@ void sega_16bit_sprite_device::draw_write(uint16_t data)
 }
 
 
+//-------------------------------------------------
+//  clip_rows -- find the rows of a sprite that
+//  land inside the cliprect, counted from 0 at
+//  scanline top and stepping by ydelta; returns
+//  false if there are none
+//-------------------------------------------------
+
+static inline bool clip_rows(const rectangle &cliprect, int top, int ydelta, int height, int &first, int &last)
+{
+	// partial updates only cover a band of scanlines, so most sprites miss it entirely
+	first = std::max(0, (ydelta > 0) ? (cliprect.min_y - top) : (top - cliprect.max_y));
+	last = std::min(height - 1, (ydelta > 0) ? (cliprect.max_y - top) : (top - cliprect.min_y));
+	return first <= last;
+}
+
+
 
 //****************************************************************************
 //  HANG ON-STYLE SPRITES
@@ -179,12 +195,17 @@ void sega_hangon_sprite_device::draw(bitmap_ind16 &bitmap, const rectangle &clip
 		int zaddr = (vzoom & 0x38) << 5;
 		int zmask = 1 << (vzoom & 7);
 
+		// rows above the cliprect still step through the zoom table; nothing below it is drawn
+		int first, last;
+		if (!clip_rows(cliprect, top, 1, bottom - top, first, last))
+			continue;
+
 		// loop from top to bottom
 		int minx = xpos;
 		int maxx = cliprect.min_x - 1;
 		int miny = cliprect.max_y + 1;
 		int maxy = cliprect.min_y - 1;
-		for (int y = top; y < bottom; y++)
+		for (int y = top; y <= top + last; y++)
 		{
 			// advance a row
 			addr += pitch;
@@ -359,12 +380,17 @@ void sega_sharrier_sprite_device::draw(bitmap_ind16 &bitmap, const rectangle &cl
 		int zaddr = (vzoom & 0x38) << 5;
 		int zmask = 1 << (vzoom & 7);
 
+		// rows above the cliprect still step through the zoom table; nothing below it is drawn
+		int first, last;
+		if (!clip_rows(cliprect, top, 1, bottom - top, first, last))
+			continue;
+
 		// loop from top to bottom
 		int minx = xpos;
 		int maxx = cliprect.min_x - 1;
 		int miny = cliprect.max_y + 1;
 		int maxy = cliprect.min_y - 1;
-		for (int y = top; y < bottom; y++)
+		for (int y = top; y <= top + last; y++)
 		{
 			// advance a row
 			addr += pitch;
@@ -552,12 +578,18 @@ void sega_sys16a_sprite_device::draw(bitmap_ind16 &bitmap, const rectangle &clip
 			set_origin(m_xoffs, m_yoffs);
 		}
 
+		// rows above the cliprect only advance the address, so skip them in one step
+		int first, last;
+		if (!clip_rows(cliprect, top, 1, bottom - top, first, last))
+			continue;
+		addr += pitch * first;
+
 		// loop from top to bottom
 		int minx = xpos;
 		int maxx = xpos;
 		int miny = cliprect.max_y + 1;
 		int maxy = cliprect.min_y - 1;
-		for (int y = top; y < bottom; y++)
+		for (int y = top + first; y <= top + last; y++)
 		{
 			// advance a row
 			addr += pitch;
@@ -739,12 +771,18 @@ void bootleg_sys16a_sprite_device::draw(bitmap_ind16 &bitmap, const rectangle &c
 			set_origin(m_xoffs, m_yoffs);
 		}
 
+		// rows above the cliprect only advance the address, so skip them in one step
+		int first, last;
+		if (!clip_rows(cliprect, top, 1, bottom - top, first, last))
+			continue;
+		addr += pitch * first;
+
 		// loop from top to bottom
 		int minx = xpos;
 		int maxx = xpos;
 		int miny = cliprect.max_y + 1;
 		int maxy = cliprect.min_y - 1;
-		for (int y = top; y < bottom; y++)
+		for (int y = top + first; y <= top + last; y++)
 		{
 			// skip drawing if not within the cliprect
 			if (y >= cliprect.min_y && y <= cliprect.max_y)
@@ -928,12 +966,24 @@ void sega_sys16b_sprite_device::draw(bitmap_ind16 &bitmap, const rectangle &clip
 			set_origin(m_xoffs, m_yoffs);
 		}
 
+		// rows above the cliprect only advance the address; the zoom accumulator is
+		// five bits wide, so the extra rows it skips can be counted in one step
+		int first, last;
+		const int rows = bottom - top;
+		if (!clip_rows(cliprect, top, 1, rows, first, last))
+		{
+			data[5] |= ((rows * vzoom) & 0x1f) << 10;
+			continue;
+		}
+		addr += pitch * (first + ((first * vzoom) >> 5));
+		data[5] |= ((first * vzoom) & 0x1f) << 10;
+
 		// loop from top to bottom
 		int minx = xpos;
 		int maxx = xpos;
 		int miny = cliprect.max_y + 1;
 		int maxy = cliprect.min_y - 1;
-		for (int y = top; y < bottom; y++)
+		for (int y = top + first; y <= top + last; y++)
 		{
 			// advance a row
 			addr += pitch;
@@ -1007,6 +1057,9 @@ void sega_sys16b_sprite_device::draw(bitmap_ind16 &bitmap, const rectangle &clip
 			}
 		}
 
+		// leave the zoom accumulator where the rows below the cliprect would have
+		data[5] = (data[5] & 0x03ff) | (((rows * vzoom) & 0x1f) << 10);
+
 		// mark dirty
 		if (minx <= maxx && miny <= maxy)
 			mark_dirty(minx, maxx, miny, maxy);
@@ -1143,9 +1196,16 @@ void sega_outrun_sprite_device::draw(bitmap_ind16 &bitmap, const rectangle &clip
 		int maxx = xpos;
 		int miny = cliprect.max_y + 1;
 		int maxy = cliprect.min_y - 1;
-		int yacc = 0;
-		int ytarget = top + ydelta * height;
-		for (int y = top; y != ytarget; y += ydelta)
+
+		// rows outside the cliprect only accumulate zoom, so skip them in one step
+		int first, last;
+		if (!clip_rows(cliprect, top, ydelta, height, first, last))
+			continue;
+		int yacc = first * vzoom;
+		addr += pitch * (yacc >> 9);
+		yacc &= 0x1ff;
+		int ytarget = top + ydelta * (last + 1);
+		for (int y = top + ydelta * first; y != ytarget; y += ydelta)
 		{
 			// skip drawing if not within the cliprect
 			if (y >= cliprect.min_y && y <= cliprect.max_y)
@@ -1336,9 +1396,16 @@ void sega_yboard_sprite_device::draw(bitmap_ind16 &bitmap, const rectangle &clip
 		int dmaxx = xpos;
 		int dminy = cliprect.max_y + 1;
 		int dmaxy = cliprect.min_y - 1;
-		int ytarget = top + ydelta * height;
-		int yacc = 0;
-		for (int y = top; y != ytarget; y += ydelta)
+
+		// rows outside the cliprect only accumulate zoom, so skip them in one step
+		int first, last;
+		if (!clip_rows(cliprect, top, ydelta, height, first, last))
+			continue;
+		int yacc = first * zoom;
+		addr += pitch * (yacc >> 9);
+		yacc &= 0x1ff;
+		int ytarget = top + ydelta * (last + 1);
+		for (int y = top + ydelta * first; y != ytarget; y += ydelta)
 		{
 			// skip drawing if not within the cliprect
 			if (y >= cliprect.min_y && y <= cliprect.max_y)
@@ -26,6 +26,11 @@
 #include "emu.h"
 #include "includes/toaplan2.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TOAPLAN2_MIX_SSE2 1
+#endif
+
 
 /***************************************************************************
 
@@ -240,6 +245,57 @@ void toaplan2_state::batrider_bank_cb(u8 layer, u32 &code)
 	code = (m_gfxrom_bank[code >> 15] << 15) | (code & 0x7fff);
 }
 
+/***************************************************************************
+
+  Dual VDP boards (Dogyuun, Batsugun)
+
+  The two chips share one priority bitmap, cleared before each draws.
+  Batsugun draws them into separate bitmaps and mixes the results;
+  Dogyuun draws VDP0 over VDP1.
+
+***************************************************************************/
+
+// Batsugun: VDP1 wins where it is opaque and either VDP0 is transparent
+// or VDP0 has the higher 0x0780 priority field
+static void toaplan2_batsugun_mix_span(u16 *vdp0, u16 const *vdp1, int count)
+{
+	int x = 0;
+#if defined(TOAPLAN2_MIX_SSE2)
+	__m128i const zero = _mm_setzero_si128();
+	__m128i const pen = _mm_set1_epi16(0x000f);
+	__m128i const pri = _mm_set1_epi16(0x0780);
+	for ( ; x + 8 <= count; x += 8)
+	{
+		__m128i const a = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&vdp0[x]));
+		__m128i const b = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&vdp1[x]));
+		__m128i const clear0 = _mm_cmpeq_epi16(_mm_and_si128(a, pen), zero);
+		__m128i const clear1 = _mm_cmpeq_epi16(_mm_and_si128(b, pen), zero);
+		__m128i const above = _mm_cmpgt_epi16(_mm_and_si128(a, pri), _mm_and_si128(b, pri)); // fields fit in 11 bits, so signed is fine
+		__m128i const use1 = _mm_andnot_si128(clear1, _mm_or_si128(clear0, above));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&vdp0[x]), _mm_or_si128(_mm_and_si128(use1, b), _mm_andnot_si128(use1, a)));
+	}
+#endif
+	for ( ; x < count; x++)
+	{
+		u16 const a = vdp0[x];
+		u16 const b = vdp1[x];
+		u16 const use1 = -u16((b & 0x000f) && (!(a & 0x000f) || ((a & 0x0780) > (b & 0x0780))));
+		vdp0[x] = (b & use1) | (a & ~use1);
+	}
+}
+
+// draws VDP0 into bitmap and VDP1 into m_secondary_render_bitmap
+void toaplan2_state::render_dual_vdp(bitmap_ind16 &bitmap, const rectangle &cliprect)
+{
+	bitmap.fill(0, cliprect);
+	m_custom_priority_bitmap.fill(0, cliprect);
+	m_vdp[0]->render_vdp(bitmap, cliprect);
+
+	m_secondary_render_bitmap.fill(0, cliprect);
+	m_custom_priority_bitmap.fill(0, cliprect);
+	m_vdp[1]->render_vdp(m_secondary_render_bitmap, cliprect);
+}
+
 // Dogyuun doesn't appear to require fancy mixing?
 u32 toaplan2_state::screen_update_dogyuun(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect)
 {
@@ -262,22 +318,19 @@ u32 toaplan2_state::screen_update_dogyuun(screen_device &screen, bitmap_ind16 &b
 // renders to 2 bitmaps, and mixes output
 u32 toaplan2_state::screen_update_batsugun(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect)
 {
-//  bitmap.fill(0, cliprect);
-//  gp9001_custom_priority_bitmap->fill(0, cliprect);
-
-	if (m_vdp[0])
+	if (!m_vdp[0] || !m_vdp[1])
 	{
-		bitmap.fill(0, cliprect);
-		m_custom_priority_bitmap.fill(0, cliprect);
-		m_vdp[0]->render_vdp(bitmap, cliprect);
-	}
-	if (m_vdp[1])
-	{
-		m_secondary_render_bitmap.fill(0, cliprect);
-		m_custom_priority_bitmap.fill(0, cliprect);
-		m_vdp[1]->render_vdp(m_secondary_render_bitmap, cliprect);
+		if (m_vdp[0])
+		{
+			bitmap.fill(0, cliprect);
+			m_custom_priority_bitmap.fill(0, cliprect);
+			m_vdp[0]->render_vdp(bitmap, cliprect);
+		}
+		return 0;
 	}
 
+	render_dual_vdp(bitmap, cliprect);
+
 	// key test places in batsugun
 	// level 2 - the two layers of clouds (will appear under background, or over ships if wrong)
 	// level 3 - the special effect 'layer' which should be under everything (will appear over background if wrong)
@@ -288,65 +341,14 @@ u32 toaplan2_state::screen_update_batsugun(screen_device &screen, bitmap_ind16 &
 	// when implemented based directly on the PAL equation it doesn't work, however, my own equations roughly based
 	// on that do.
 	//
-
-	if (m_vdp[0] && m_vdp[1])
-	{
-		for (int y = cliprect.min_y; y <= cliprect.max_y; y++)
-		{
-			u16 *const src_vdp0 = &bitmap.pix(y);
-			u16 const *const src_vdp1 = &m_secondary_render_bitmap.pix(y);
-
-			for (int x = cliprect.min_x; x <= cliprect.max_x; x++)
-			{
-				const u16 GPU0_LUTaddr = src_vdp0[x];
-				const u16 GPU1_LUTaddr = src_vdp1[x];
-
-				// these equations is derived from the PAL, but doesn't seem to work?
-
-				const bool COMPARISON = ((GPU0_LUTaddr & 0x0780) > (GPU1_LUTaddr & 0x0780));
-
-				// note: GPU1_LUTaddr & 0x000f - transparency check for vdp1? (gfx are 4bpp, the low 4 bits of the lookup would be the pixel data value)
-#if 0
-				int result =
-							((GPU0_LUTaddr & 0x0008) & !COMPARISON)
-						| ((GPU0_LUTaddr & 0x0008) & !(GPU1_LUTaddr & 0x000f))
-						| ((GPU0_LUTaddr & 0x0004) & !COMPARISON)
-						| ((GPU0_LUTaddr & 0x0004) & !(GPU1_LUTaddr & 0x000f))
-						| ((GPU0_LUTaddr & 0x0002) & !COMPARISON)
-						| ((GPU0_LUTaddr & 0x0002) & !(GPU1_LUTaddr & 0x000f))
-						| ((GPU0_LUTaddr & 0x0001) & !COMPARISON)
-						| ((GPU0_LUTaddr & 0x0001) & !(GPU1_LUTaddr & 0x000f));
-
-				if (result) src_vdp0[x] = GPU0_LUTaddr;
-				else src_vdp0[x] = GPU1_LUTaddr;
-#endif
-				// this seems to work tho?
-				if (!(GPU1_LUTaddr & 0x000f))
-				{
-					src_vdp0[x] = GPU0_LUTaddr;
-				}
-				else
-				{
-					if (!(GPU0_LUTaddr & 0x000f))
-					{
-						src_vdp0[x] = GPU1_LUTaddr; // bg pen
-					}
-					else
-					{
-						if (COMPARISON)
-						{
-							src_vdp0[x] = GPU1_LUTaddr;
-						}
-						else
-						{
-							src_vdp0[x] = GPU0_LUTaddr;
-						}
-
-					}
-				}
-			}
-		}
-	}
+	// the PAL derived version, kept for reference:
+	//
+	//  COMPARISON = ((GPU0_LUTaddr & 0x0780) > (GPU1_LUTaddr & 0x0780));
+	//  result = (GPU0_LUTaddr & 0x000f) & (!COMPARISON | !(GPU1_LUTaddr & 0x000f)) (per bit)
+	//  src_vdp0[x] = result ? GPU0_LUTaddr : GPU1_LUTaddr;
+	//
+	for (int y = cliprect.min_y; y <= cliprect.max_y; y++)
+		toaplan2_batsugun_mix_span(&bitmap.pix(y, cliprect.min_x), &m_secondary_render_bitmap.pix(y, cliprect.min_x), cliprect.width());
 
 	return 0;
 }
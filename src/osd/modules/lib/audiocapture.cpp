@@ -0,0 +1,241 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    audiocapture.cpp
+
+    Capture of the final mixed audio stream to WAV or FLAC on a
+    background thread, with optional hashing for regression runs.
+
+    The emulation thread only copies samples into a bounded ring; the
+    writer thread encodes and writes them. If the writer falls more than
+    BUFFER_SECONDS behind, the emulation waits for it rather than losing
+    audio, so the capture is always complete.
+
+    Alongside the audio a "<file>.frames" list is written giving, for
+    every video frame, the index of the audio sample that coincides with
+    its start. The index is derived from emulated time rather than from
+    how the sound system happened to chunk its updates, so it is exact.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "audiocapture.h"
+
+#include "corestr.h"
+#include "flac.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+//-------------------------------------------------
+//  audio_capture - constructor
+//-------------------------------------------------
+
+audio_capture::audio_capture(const char *filename, int sample_rate, bool hash)
+	: m_ring(size_t(sample_rate) * BUFFER_SECONDS)
+	, m_sample_rate(sample_rate)
+	, m_filename(filename != nullptr ? filename : "")
+	, m_hash(hash)
+	, m_samples(0)
+	, m_chunk(size_t(sample_rate) * BUFFER_SECONDS * 2)
+	, m_exit(false)
+{
+	if (!m_filename.empty())
+	{
+		osd_file::error filerr = util::core_file::open(m_filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, m_file);
+		if (filerr != osd_file::error::NONE)
+		{
+			osd_printf_error("Unable to open audio capture file %s\n", m_filename);
+			m_filename.clear();
+		}
+		else
+		{
+			// pick the format from the extension
+			std::string::size_type const dot = m_filename.find_last_of('.');
+			if ((dot != std::string::npos) && !core_stricmp(m_filename.c_str() + dot, ".flac"))
+			{
+				m_flac = std::make_unique<flac_encoder>();
+				m_flac->set_sample_rate(sample_rate);
+				m_flac->set_num_channels(2);
+				if (!m_flac->reset(*m_file))
+				{
+					osd_printf_error("Unable to start FLAC encoder for %s\n", m_filename);
+					m_flac.reset();
+					m_file.reset();
+					m_filename.clear();
+				}
+			}
+			else
+			{
+				// sizes are filled in when the capture is closed
+				write_wav_header(0);
+			}
+		}
+
+		if (!m_filename.empty())
+			util::core_file::open(m_filename + ".frames", OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, m_markers_file);
+	}
+
+	m_thread = std::thread([this] () { thread_proc(); });
+}
+
+
+//-------------------------------------------------
+//  ~audio_capture - destructor
+//-------------------------------------------------
+
+audio_capture::~audio_capture()
+{
+	// let the writer drain everything still buffered
+	m_exit = true;
+	m_thread.join();
+
+	if (m_flac)
+		m_flac->finish();
+	else if (m_file)
+		write_wav_header(uint32_t(std::min<uint64_t>(m_samples * 4, 0xffffffffU - 36)));
+	m_flac.reset();
+	m_file.reset();
+	m_markers_file.reset();
+
+	if (!m_filename.empty())
+		osd_printf_info("Audio capture: %u samples written to %s\n", m_samples, m_filename);
+
+	if (m_hash)
+	{
+		util::crc32_t const crc = m_crc.finish();
+		util::sha1_t const sha1 = m_sha1.finish();
+		osd_printf_info("Audio hash: %u samples CRC(%s) SHA1(%s)\n", m_samples, crc.as_string(), sha1.as_string());
+	}
+}
+
+
+//-------------------------------------------------
+//  add_audio - queue samples for the writer,
+//  waiting if it has fallen too far behind
+//-------------------------------------------------
+
+void audio_capture::add_audio(const int16_t *buffer, int samples_this_frame)
+{
+	size_t remaining = samples_this_frame;
+	while (remaining > 0)
+	{
+		size_t const written = m_ring.write(buffer, remaining);
+		buffer += written * 2;
+		remaining -= written;
+		if (remaining > 0)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+
+//-------------------------------------------------
+//  mark_frame - note which sample a video frame
+//  starts at
+//-------------------------------------------------
+
+void audio_capture::mark_frame(uint64_t frame, uint64_t sample)
+{
+	if (!m_markers_file)
+		return;
+
+	std::lock_guard<std::mutex> lock(m_marker_lock);
+	m_markers.emplace_back(frame, sample);
+}
+
+
+//-------------------------------------------------
+//  thread_proc - drain the ring until told to
+//  stop, then drain whatever is left
+//-------------------------------------------------
+
+void audio_capture::thread_proc()
+{
+	while (!m_exit)
+	{
+		drain();
+		write_frame_markers();
+		std::this_thread::sleep_for(std::chrono::milliseconds(WRITER_INTERVAL_MSEC));
+	}
+	drain();
+	write_frame_markers();
+}
+
+
+//-------------------------------------------------
+//  drain - hash and write everything currently
+//  in the ring
+//-------------------------------------------------
+
+void audio_capture::drain()
+{
+	size_t frames;
+	while ((frames = m_ring.read(&m_chunk[0], m_chunk.size() / 2)) != 0)
+	{
+		// WAV data and the hashes are defined on little-endian samples
+		if (m_flac)
+			m_flac->encode_interleaved(&m_chunk[0], frames);
+		for (size_t i = 0; i < frames * 2; i++)
+			m_chunk[i] = little_endianize_int16(m_chunk[i]);
+		if (m_file && !m_flac)
+			m_file->write(&m_chunk[0], frames * 4);
+		if (m_hash)
+		{
+			m_crc.append(&m_chunk[0], frames * 4);
+			m_sha1.append(&m_chunk[0], frames * 4);
+		}
+		m_samples += frames;
+	}
+}
+
+
+//-------------------------------------------------
+//  write_wav_header - write a 16-bit stereo RIFF
+//  header at the start of the file
+//-------------------------------------------------
+
+void audio_capture::write_wav_header(uint32_t data_bytes)
+{
+	auto const put16 = [] (uint8_t *dest, uint16_t value) { dest[0] = uint8_t(value); dest[1] = uint8_t(value >> 8); };
+	auto const put32 = [] (uint8_t *dest, uint32_t value) { for (int i = 0; i < 4; i++) dest[i] = uint8_t(value >> (i * 8)); };
+
+	uint8_t header[44];
+	memcpy(&header[0], "RIFF", 4);
+	put32(&header[4], data_bytes + 36);
+	memcpy(&header[8], "WAVEfmt ", 8);
+	put32(&header[16], 16);                     // format chunk size
+	put16(&header[20], 1);                      // PCM
+	put16(&header[22], 2);                      // channels
+	put32(&header[24], m_sample_rate);          // sample rate
+	put32(&header[28], m_sample_rate * 4);      // bytes per second
+	put16(&header[32], 4);                      // bytes per frame
+	put16(&header[34], 16);                     // bits per sample
+	memcpy(&header[36], "data", 4);
+	put32(&header[40], data_bytes);
+
+	m_file->seek(0, SEEK_SET);
+	m_file->write(header, sizeof(header));
+	m_file->seek(0, SEEK_END);
+}
+
+
+//-------------------------------------------------
+//  write_frame_markers - flush the pending video
+//  frame offsets
+//-------------------------------------------------
+
+void audio_capture::write_frame_markers()
+{
+	if (!m_markers_file)
+		return;
+
+	std::vector<std::pair<uint64_t, uint64_t> > markers;
+	{
+		std::lock_guard<std::mutex> lock(m_marker_lock);
+		markers.swap(m_markers);
+	}
+	for (auto const &marker : markers)
+		m_markers_file->printf("%u %u\n", marker.first, marker.second);
+}
@@ -0,0 +1,77 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    audiocapture.h
+
+    Capture of the final mixed audio stream to WAV or FLAC on a
+    background thread, with optional hashing for regression runs.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef MAME_OSD_LIB_AUDIOCAPTURE_H
+#define MAME_OSD_LIB_AUDIOCAPTURE_H
+
+#include "audioring.h"
+
+#include "corefile.h"
+#include "hashing.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+class flac_encoder;
+
+
+// ======================> audio_capture
+
+class audio_capture
+{
+public:
+	// construction/destruction
+	audio_capture(const char *filename, int sample_rate, bool hash);
+	~audio_capture();
+
+	// called from the emulation thread
+	void add_audio(const int16_t *buffer, int samples_this_frame);
+	void mark_frame(uint64_t frame, uint64_t sample);
+
+private:
+	// amount of audio buffered between the emulation and the writer
+	static constexpr int BUFFER_SECONDS = 2;
+
+	// interval at which the writer wakes up to drain the buffer
+	static constexpr int WRITER_INTERVAL_MSEC = 10;
+
+	void thread_proc();
+	void drain();
+	void write_wav_header(uint32_t data_bytes);
+	void write_frame_markers();
+
+	// internal state
+	audio_ring              m_ring;             // samples waiting for the writer
+	int                     m_sample_rate;      // sample rate of the stream
+	std::string             m_filename;         // output file name (empty if only hashing)
+	util::core_file::ptr    m_file;             // audio output file
+	util::core_file::ptr    m_markers_file;     // video frame to sample offset list
+	std::unique_ptr<flac_encoder> m_flac;       // FLAC encoder (nullptr when writing WAV)
+	bool                    m_hash;             // compute hashes of the stream?
+	util::crc32_creator     m_crc;              // CRC of the little-endian sample data
+	util::sha1_creator      m_sha1;             // SHA-1 of the little-endian sample data
+	uint64_t                m_samples;          // stereo frames written so far
+	std::vector<int16_t>    m_chunk;            // samples being processed by the writer
+	std::mutex              m_marker_lock;      // protects m_markers
+	std::vector<std::pair<uint64_t, uint64_t> > m_markers; // pending (video frame, sample) pairs
+	std::atomic<bool>       m_exit;             // tells the writer to finish
+	std::thread             m_thread;           // writer thread
+};
+
+#endif // MAME_OSD_LIB_AUDIOCAPTURE_H
@@ -0,0 +1,258 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    audioring.cpp
+
+    Lock-free audio ring between the emulation and a feeder thread that
+    drives the sound module with dynamic rate control.
+
+    The emulation delivers a frame's worth of audio at a time, whenever
+    frame pacing lets it. The feeder thread instead services the sound
+    module every few milliseconds with a fixed amount of audio, so the
+    module sees a steady stream no matter how unevenly the frames arrive.
+    To keep the ring from slowly draining or filling up because the two
+    clocks don't match exactly, the feeder resamples by a ratio that is
+    steered from the ring's fill level, never more than half a percent
+    from nominal so that the pitch change stays inaudible.
+
+    Sound modules expect to be called from one thread at a time, so the
+    feeder holds a lock around every call into the module, including the
+    volume changes the emulation thread forwards through it.
+
+***************************************************************************/
+
+#include "audioring.h"
+
+#include "modules/sound/sound_module.h"
+
+#include <algorithm>
+
+
+//**************************************************************************
+//  AUDIO RING
+//**************************************************************************
+
+//-------------------------------------------------
+//  audio_ring - constructor
+//-------------------------------------------------
+
+audio_ring::audio_ring(size_t frames)
+	: m_buffer((frames + 1) * 2, 0)
+	, m_size(frames + 1)
+	, m_read(0)
+	, m_write(0)
+{
+}
+
+
+//-------------------------------------------------
+//  available - number of frames ready to read
+//-------------------------------------------------
+
+size_t audio_ring::available() const
+{
+	size_t const w = m_write.load(std::memory_order_acquire);
+	size_t const r = m_read.load(std::memory_order_relaxed);
+	return (w + m_size - r) % m_size;
+}
+
+
+//-------------------------------------------------
+//  write - append as many frames as fit, return
+//  the number written
+//-------------------------------------------------
+
+size_t audio_ring::write(const int16_t *samples, size_t frames)
+{
+	size_t const w = m_write.load(std::memory_order_relaxed);
+	size_t const r = m_read.load(std::memory_order_acquire);
+	frames = std::min(frames, (r + m_size - w - 1) % m_size);
+
+	size_t const first = std::min(frames, m_size - w);
+	std::copy_n(samples, first * 2, &m_buffer[w * 2]);
+	std::copy_n(samples + first * 2, (frames - first) * 2, &m_buffer[0]);
+
+	m_write.store((w + frames) % m_size, std::memory_order_release);
+	return frames;
+}
+
+
+//-------------------------------------------------
+//  read - remove up to the requested number of
+//  frames, return the number read
+//-------------------------------------------------
+
+size_t audio_ring::read(int16_t *samples, size_t frames)
+{
+	size_t const r = m_read.load(std::memory_order_relaxed);
+	size_t const w = m_write.load(std::memory_order_acquire);
+	frames = std::min(frames, (w + m_size - r) % m_size);
+
+	size_t const first = std::min(frames, m_size - r);
+	std::copy_n(&m_buffer[r * 2], first * 2, samples);
+	std::copy_n(&m_buffer[0], (frames - first) * 2, samples + first * 2);
+
+	m_read.store((r + frames) % m_size, std::memory_order_release);
+	return frames;
+}
+
+
+
+//**************************************************************************
+//  AUDIO FEEDER
+//**************************************************************************
+
+//-------------------------------------------------
+//  audio_feeder - constructor
+//-------------------------------------------------
+
+audio_feeder::audio_feeder(sound_module &sound, int sample_rate, int latency, const char *tracefile)
+	: m_sound(sound)
+	, m_ring(size_t(sample_rate) * (latency + 1) * 4 / 60)
+	, m_target(size_t(sample_rate) * (latency + 1) / 60)
+	, m_sample_rate(sample_rate)
+	, m_period_frames(std::max(1, sample_rate / SERVICE_HZ))
+	, m_ratio(1.0)
+	, m_position(0.0)
+	, m_throttled(true)
+	, m_exit(false)
+	, m_trace(nullptr)
+	, m_start(std::chrono::steady_clock::now())
+{
+	m_last[0] = m_last[1] = 0;
+	m_output.resize(m_period_frames * 2);
+	m_input.resize((size_t(m_period_frames * (1.0 + MAX_RATE_ADJUST)) + 3) * 2);
+
+	if (tracefile != nullptr && tracefile[0] != 0)
+	{
+		m_trace = fopen(tracefile, "w");
+		if (m_trace != nullptr)
+			fprintf(m_trace, "msec,fill,target,ratio,frames\n");
+	}
+
+	m_thread = std::thread([this] () { thread_proc(); });
+}
+
+
+//-------------------------------------------------
+//  ~audio_feeder - destructor
+//-------------------------------------------------
+
+audio_feeder::~audio_feeder()
+{
+	m_exit = true;
+	m_thread.join();
+	if (m_trace != nullptr)
+		fclose(m_trace);
+}
+
+
+//-------------------------------------------------
+//  update_audio_stream - queue a frame's worth of
+//  samples from the emulation
+//-------------------------------------------------
+
+void audio_feeder::update_audio_stream(bool is_throttled, const int16_t *buffer, int samples_this_frame)
+{
+	m_throttled = is_throttled;
+
+	// when the ring is full the newest samples are lost, just as a full
+	// sound module buffer would lose them
+	m_ring.write(buffer, samples_this_frame);
+}
+
+
+//-------------------------------------------------
+//  set_mastervolume - forward a volume change to
+//  the sound module
+//-------------------------------------------------
+
+void audio_feeder::set_mastervolume(int attenuation)
+{
+	std::lock_guard<std::mutex> lock(m_sound_lock);
+	m_sound.set_mastervolume(attenuation);
+}
+
+
+//-------------------------------------------------
+//  thread_proc - service the sound module at a
+//  fixed interval until told to stop
+//-------------------------------------------------
+
+void audio_feeder::thread_proc()
+{
+	auto const period = std::chrono::microseconds(1000000 / SERVICE_HZ);
+	auto next = std::chrono::steady_clock::now();
+	while (!m_exit)
+	{
+		service();
+
+		// if we fell far behind (e.g. the process was suspended), start over
+		// rather than trying to catch up with a burst
+		next += period;
+		auto const now = std::chrono::steady_clock::now();
+		if (now - next > period * 10)
+			next = now;
+		std::this_thread::sleep_until(next);
+	}
+}
+
+
+//-------------------------------------------------
+//  service - resample one period of audio from
+//  the ring and pass it to the sound module
+//-------------------------------------------------
+
+void audio_feeder::service()
+{
+	// steer the ratio from the fill level: consume faster when the ring is
+	// fuller than the target, slower when it's emptier
+	size_t const fill = m_ring.available();
+	double const error = (double(fill) - double(m_target)) / double(m_target);
+	m_ratio = 1.0 + std::clamp(error, -1.0, 1.0) * MAX_RATE_ADJUST;
+
+	// fetch the whole input frames this period's output will step over; the
+	// previous period's last frame sits in front of them for interpolation
+	size_t const wanted = size_t(m_position + m_period_frames * m_ratio);
+	m_input[0] = m_last[0];
+	m_input[1] = m_last[1];
+	size_t const got = m_ring.read(&m_input[2], std::min(wanted, m_input.size() / 2 - 1));
+
+	// linear interpolation between neighbouring input frames
+	int frames = 0;
+	double pos = m_position;
+	while (frames < m_period_frames && pos < double(got))
+	{
+		size_t const index = size_t(pos);
+		float const frac = float(pos - double(index));
+		for (int ch = 0; ch < 2; ch++)
+		{
+			float const a = m_input[index * 2 + ch];
+			float const b = m_input[index * 2 + 2 + ch];
+			m_output[frames * 2 + ch] = int16_t(a + (b - a) * frac);
+		}
+		frames++;
+		pos += m_ratio;
+	}
+
+	// carry the fractional position and the last consumed frame over
+	size_t const consumed = std::min(size_t(pos), got);
+	m_position = pos - double(consumed);
+	m_last[0] = m_input[consumed * 2];
+	m_last[1] = m_input[consumed * 2 + 1];
+
+	// an empty ring means the emulation is paused or running slow; let the
+	// sound module handle the underrun the way it always has
+	if (frames > 0)
+	{
+		std::lock_guard<std::mutex> lock(m_sound_lock);
+		m_sound.update_audio_stream(m_throttled, &m_output[0], frames);
+	}
+
+	if (m_trace != nullptr)
+	{
+		auto const msec = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start).count();
+		fprintf(m_trace, "%lld,%u,%u,%.6f,%d\n", (long long)msec, unsigned(fill), unsigned(m_target), m_ratio, frames);
+	}
+}
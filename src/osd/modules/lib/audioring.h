@@ -0,0 +1,102 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    audioring.h
+
+    Lock-free audio ring between the emulation and a feeder thread that
+    drives the sound module with dynamic rate control.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef MAME_OSD_LIB_AUDIORING_H
+#define MAME_OSD_LIB_AUDIORING_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+class sound_module;
+
+
+// ======================> audio_ring
+
+// single-producer/single-consumer ring of interleaved stereo samples
+class audio_ring
+{
+public:
+	// construction/destruction
+	audio_ring(size_t frames);
+
+	// getters
+	size_t capacity() const { return m_size - 1; }
+	size_t available() const;
+
+	// producer side
+	size_t write(const int16_t *samples, size_t frames);
+
+	// consumer side
+	size_t read(int16_t *samples, size_t frames);
+
+private:
+	// internal state
+	std::vector<int16_t>    m_buffer;           // interleaved stereo samples
+	size_t                  m_size;             // size of the ring in frames (one always kept free)
+	std::atomic<size_t>     m_read;             // next frame to read, owned by the consumer
+	std::atomic<size_t>     m_write;            // next frame to write, owned by the producer
+};
+
+
+// ======================> audio_feeder
+
+// thread that drains the ring into a sound module at a steady pace,
+// nudging the resampling ratio to hold the ring at its target fill level;
+// while it exists, every call into the sound module must go through it
+class audio_feeder
+{
+public:
+	// construction/destruction
+	audio_feeder(sound_module &sound, int sample_rate, int latency, const char *tracefile);
+	~audio_feeder();
+
+	// producer side, called from the emulation thread
+	void update_audio_stream(bool is_throttled, const int16_t *buffer, int samples_this_frame);
+	void set_mastervolume(int attenuation);
+
+private:
+	// maximum deviation from the nominal rate (0.5%)
+	static constexpr double MAX_RATE_ADJUST = 0.005;
+
+	// interval at which the feeder thread services the sound module
+	static constexpr int SERVICE_HZ = 200;
+
+	void thread_proc();
+	void service();
+
+	// internal state
+	sound_module &          m_sound;            // sound module being fed
+	std::mutex              m_sound_lock;       // serialises calls into the sound module
+	audio_ring              m_ring;             // samples from the emulation
+	size_t                  m_target;           // fill level the rate control aims for, in frames
+	int                     m_sample_rate;      // nominal output sample rate
+	int                     m_period_frames;    // output frames per service period
+	double                  m_ratio;            // input frames consumed per output frame
+	double                  m_position;         // fractional input position past m_last
+	int16_t                 m_last[2];          // most recently consumed input frame
+	std::vector<int16_t>    m_input;            // input frames for one service period
+	std::vector<int16_t>    m_output;           // resampled output for one service period
+	std::atomic<bool>       m_throttled;        // throttle state reported by the producer
+	std::atomic<bool>       m_exit;             // tells the thread to stop
+	FILE *                  m_trace;            // fill level trace (nullptr if not tracing)
+	std::chrono::steady_clock::time_point m_start; // time the feeder started, for the trace
+	std::thread             m_thread;           // feeder thread
+};
+
+#endif // MAME_OSD_LIB_AUDIORING_H
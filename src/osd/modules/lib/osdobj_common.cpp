@@ -131,6 +131,10 @@ const options_entry osd_options::s_option_entries[] =
 	{ nullptr,                                nullptr,          OPTION_HEADER,    "OSD SOUND OPTIONS" },
 	{ OSDOPTION_SOUND,                        OSDOPTVAL_AUTO,   OPTION_STRING,    "sound output method: " },
 	{ OSDOPTION_AUDIO_LATENCY "(0-5)",        "2",              OPTION_INTEGER,   "set audio latency (increase to reduce glitches, decrease for responsiveness)" },
+	{ OSDOPTION_AUDIO_RING,                   "0",              OPTION_BOOLEAN,   "feed the sound output from a separate thread with dynamic rate control" },
+	{ OSDOPTION_AUDIO_FILL_TRACE,             "",               OPTION_STRING,    "write the audio ring fill level to this file (also works with -sound none)" },
+	{ OSDOPTION_AUDIO_CAPTURE,                "",               OPTION_STRING,    "capture the final mixed audio to this .wav or .flac file from a background thread" },
+	{ OSDOPTION_AUDIO_HASH,                   "0",              OPTION_BOOLEAN,   "print CRC and SHA-1 of the final mixed audio on exit" },
 
 #ifndef NO_USE_PORTAUDIO
 	{ nullptr,                                nullptr,          OPTION_HEADER,    "PORTAUDIO OPTIONS" },
@@ -195,6 +199,9 @@ osd_common_t::osd_common_t(osd_options &options)
 	, m_output(nullptr)
 	, m_monitor_module(nullptr)
 	, m_watchdog(nullptr)
+	, m_audio_feeder(nullptr)
+	, m_audio_capture(nullptr)
+	, m_audio_capture_frames(0)
 {
 	osd_output::push(this);
 }
@@ -541,7 +548,15 @@ void osd_common_t::update_audio_stream(const int16_t *buffer, int samples_this_f
 	// It provides an array of stereo samples in L-R order which should be
 	// output at the configured sample_rate.
 	//
-	m_sound->update_audio_stream(m_machine->video().throttled(), buffer,samples_this_frame);
+	// Frames replayed by rollback netplay have already been heard once, so
+	// their audio is dropped rather than queued behind the live stream.
+	//
+	if (m_machine->video().resimulating())
+		return;
+	if (m_audio_feeder)
+		m_audio_feeder->update_audio_stream(m_machine->video().throttled(), buffer, samples_this_frame);
+	else
+		m_sound->update_audio_stream(m_machine->video().throttled(), buffer,samples_this_frame);
 }
 
 
@@ -558,7 +573,9 @@ void osd_common_t::set_mastervolume(int attenuation)
 	//    while (attenuation++ < 0)
 	//       volume /= 1.122018454;      //  = (10 ^ (1/20)) = 1dB
 	//
-	if (m_sound != nullptr)
+	if (m_audio_feeder)
+		m_audio_feeder->set_mastervolume(attenuation);
+	else if (m_sound != nullptr)
 		m_sound->set_mastervolume(attenuation);
 }
 
@@ -601,7 +618,21 @@ std::vector<ui::menu_item> osd_common_t::get_slider_list()
 
 void osd_common_t::add_audio_to_recording(const int16_t *buffer, int samples_this_frame)
 {
-	// Do nothing
+	// replayed netplay frames were captured the first time around
+	if (m_audio_capture && !machine().video().resimulating())
+		m_audio_capture->add_audio(buffer, samples_this_frame);
+}
+
+
+//-------------------------------------------------
+//  audio_capture_frame - note where the current
+//  video frame falls in the captured audio
+//-------------------------------------------------
+
+void osd_common_t::audio_capture_frame()
+{
+	if (!machine().video().resimulating())
+		m_audio_capture->mark_frame(m_audio_capture_frames++, machine().time().as_ticks(machine().sample_rate()));
 }
 
 
@@ -686,6 +717,17 @@ void osd_common_t::init_subsystems()
 
 	m_mod_man.init(options());
 
+	// a fill level trace implies the ring, so that it can be used headless
+	if (options().audio_ring() || options().audio_fill_trace()[0] != 0)
+		m_audio_feeder = std::make_unique<audio_feeder>(*m_sound, options().sample_rate(), options().audio_latency(), options().audio_fill_trace());
+
+	// the capture sees the mix whether or not there is a sound module
+	if (options().audio_capture()[0] != 0 || options().audio_hash())
+	{
+		m_audio_capture = std::make_unique<audio_capture>(options().audio_capture(), machine().sample_rate(), options().audio_hash());
+		machine().add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&osd_common_t::audio_capture_frame, this));
+	}
+
 	input_init();
 	// we need pause callbacks
 	machine().add_notifier(MACHINE_NOTIFY_PAUSE, machine_notify_delegate(&osd_common_t::input_pause, this));
@@ -704,6 +746,12 @@ bool osd_common_t::window_init()
 
 bool osd_common_t::no_sound()
 {
+	// keep the stream flowing into the ring when its fill level is traced
+	if (options().audio_fill_trace()[0] != 0)
+		return false;
+	// the capture needs the mix at the configured rate rather than the reduced no-sound rate
+	if (options().audio_capture()[0] != 0 || options().audio_hash())
+		return false;
 	return (strcmp(options().sound(),"none")==0) ? true : false;
 }
 
@@ -751,6 +799,13 @@ void osd_common_t::window_exit()
 
 void osd_common_t::osd_exit()
 {
+	// stop the feeder thread before the sound module exits, so that
+	// nothing calls into the module while it shuts down
+	m_audio_feeder.reset();
+
+	// finish writing any captured audio
+	m_audio_capture.reset();
+
 	m_mod_man.exit();
 
 	exit_subsystems();
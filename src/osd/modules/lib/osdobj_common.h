@@ -24,6 +24,8 @@
 #include "modules/midi/midi_module.h"
 #include "modules/output/output_module.h"
 #include "modules/monitor/monitor_module.h"
+#include "modules/lib/audiocapture.h"
+#include "modules/lib/audioring.h"
 #include "emuopts.h"
 #include "../frontend/mame/ui/menuitem.h"
 #include <list>
@@ -75,6 +77,10 @@
 
 #define OSDOPTION_SOUND                 "sound"
 #define OSDOPTION_AUDIO_LATENCY         "audio_latency"
+#define OSDOPTION_AUDIO_RING            "audio_ring"
+#define OSDOPTION_AUDIO_FILL_TRACE      "audio_fill_trace"
+#define OSDOPTION_AUDIO_CAPTURE         "audio_capture"
+#define OSDOPTION_AUDIO_HASH            "audio_hash"
 
 #define OSDOPTION_PA_API                "pa_api"
 #define OSDOPTION_PA_DEVICE             "pa_device"
@@ -157,6 +163,10 @@ public:
 	// sound options
 	const char *sound() const { return value(OSDOPTION_SOUND); }
 	int audio_latency() const { return int_value(OSDOPTION_AUDIO_LATENCY); }
+	bool audio_ring() const { return bool_value(OSDOPTION_AUDIO_RING); }
+	const char *audio_fill_trace() const { return value(OSDOPTION_AUDIO_FILL_TRACE); }
+	const char *audio_capture() const { return value(OSDOPTION_AUDIO_CAPTURE); }
+	bool audio_hash() const { return bool_value(OSDOPTION_AUDIO_HASH); }
 
 	// CoreAudio specific options
 	const char *audio_output() const { return value(OSDOPTION_AUDIO_OUTPUT); }
@@ -237,6 +247,8 @@ public:
 
 	virtual void input_resume();
 
+	void audio_capture_frame();
+
 	virtual void exit_subsystems();
 	virtual void video_exit();
 	virtual void window_exit();
@@ -305,6 +317,9 @@ protected:
 	output_module*  m_output;
 	monitor_module* m_monitor_module;
 	std::unique_ptr<osd_watchdog> m_watchdog;
+	std::unique_ptr<audio_feeder> m_audio_feeder;
+	std::unique_ptr<audio_capture> m_audio_capture;
+	uint64_t        m_audio_capture_frames;
 	std::vector<ui::menu_item> m_sliders;
 
 private: